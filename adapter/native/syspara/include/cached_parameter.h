@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYSTEM_CACHED_PARAMETER_H
+#define SYSTEM_CACHED_PARAMETER_H
+
+#include <string>
+
+#include "parameters.h"
+
+namespace OHOS {
+namespace system {
+/*
+ * A system parameter read many times, typed as T: bool, one of the integer types accepted by
+ * GetIntParameter and GetUintParameter, double, std::chrono::milliseconds or std::string.
+ * The parameter is looked up by name once. Later reads only compare its commit ID with the one
+ * of the last read, the value is fetched and parsed again only when it changed, so reading an
+ * unchanged parameter allocates nothing.
+ * An instance is not thread safe, keep one per thread or guard it.
+ */
+template<typename T>
+class CachedParameter {
+public:
+    CachedParameter(const std::string& key, const T& def) : key_(key), def_(def), value_(def) {}
+
+    /*
+     * Returns the current value of the parameter, or `def` when it is empty, doesn't exist
+     * or isn't a valid T. The reference stays valid until the next call to Get.
+     */
+    const T& Get()
+    {
+        if (handle_ == INVALID_HANDLE) {
+            handle_ = FindParameter(key_);
+            if (handle_ == INVALID_HANDLE) {
+                return def_;
+            }
+        }
+        unsigned int commitId = GetParameterCommitId(handle_);
+        if (!valid_ || (commitId == INVALID_COMMIT_ID) || (commitId != commitId_)) {
+            T value = def_;
+            value_ = ParseParameterValue(GetParameterValue(handle_), value) ? value : def_;
+            commitId_ = commitId;
+            valid_ = (commitId != INVALID_COMMIT_ID);
+        }
+        return value_;
+    }
+
+    const std::string& GetKey() const
+    {
+        return key_;
+    }
+
+private:
+    static constexpr unsigned int INVALID_HANDLE = static_cast<unsigned int>(-1);
+    static constexpr unsigned int INVALID_COMMIT_ID = static_cast<unsigned int>(-1);
+
+    const std::string key_;
+    const T def_;
+    T value_;
+    unsigned int handle_ = INVALID_HANDLE;
+    unsigned int commitId_ = INVALID_COMMIT_ID;
+    bool valid_ = false;
+};
+} // namespace system
+} // namespace OHOS
+
+#endif // SYSTEM_CACHED_PARAMETER_H
@@ -16,8 +16,13 @@
 #ifndef SYSTEM_PARAMETERS_H
 #define SYSTEM_PARAMETERS_H
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace OHOS {
 namespace system {
@@ -27,6 +32,12 @@ namespace system {
  */
 std::string GetParameter(const std::string& key, const std::string& def);
 
+/*
+ * Returns the current values of the system parameters `keys`, in the same order.
+ * Parameters that are empty or don't exist are returned as `def`.
+ */
+std::vector<std::string> GetParameters(const std::vector<std::string>& keys, const std::string& def);
+
 /*
  * Returns true if the system parameter `key` has the value "1", "y", "yes", "on", or "true",
  * false for "0", "n", "no", "off", or "false", or `def` otherwise.
@@ -50,6 +61,34 @@ T GetIntParameter(const std::string& key, T def, T min = std::numeric_limits<T>:
 template<typename T>
 T GetUintParameter(const std::string& key, T def, T max = std::numeric_limits<T>::max());
 
+/*
+ * Returns the finite floating point number the system parameter `key` holds, or `def` when it
+ * is empty, doesn't exist or isn't a number.
+ */
+double GetDoubleParameter(const std::string& key, double def);
+
+/*
+ * Returns the duration the system parameter `key` holds: an integer followed by "ms", "s", "m"
+ * or "h", milliseconds when there is no unit. Returns no value when the parameter is empty,
+ * doesn't exist or isn't a duration.
+ */
+std::optional<std::chrono::milliseconds> GetDurationParameter(const std::string& key);
+
+/*
+ * Returns the size in bytes the system parameter `key` holds: an integer optionally followed by
+ * "K", "M" or "G", each 1024 times the one before. Returns no value when the parameter is empty,
+ * doesn't exist, isn't a size or doesn't fit in 64 bits.
+ */
+std::optional<uint64_t> GetSizeParameter(const std::string& key);
+
+/*
+ * Parses `value` as the Get*Parameter function of T would, or copies it when T is std::string.
+ * T may also be double or std::chrono::milliseconds. Returns false, leaving `out` alone, when
+ * it is not a valid T.
+ */
+template<typename T>
+bool ParseParameterValue(const std::string& value, T& out);
+
 /*
  * Sets the system parameter `key` to `value`.
  * Note that system parameter setting is inherently asynchronous so a return value of `true`
@@ -58,10 +97,61 @@ T GetUintParameter(const std::string& key, T def, T max = std::numeric_limits<T>
  */
 bool SetParameter(const std::string& key, const std::string& value);
 
+/*
+ * Sets the system parameters `keys` to `values`, `values[i]` being the value of `keys[i]`.
+ * Returns false when the sizes differ or any of the keys could not be set.
+ */
+bool SetParameters(const std::vector<std::string>& keys, const std::vector<std::string>& values);
+
 int WaitParameter(const std::string& key, const std::string& value, int timeout);
 
 unsigned int FindParameter(const std::string& key);
 
+/*
+ * Overloads on NUL-terminated strings, they build no std::string for the key nor the value.
+ * A null key is handled as a parameter that doesn't exist.
+ */
+std::string GetParameter(const char* key, const char* def);
+
+/*
+ * Copies the current value of the system parameter `key` into `value`, a buffer of `len` bytes.
+ * Returns the length of the value, 0 if the parameter is empty or doesn't exist, or -1 if the
+ * value doesn't fit in the buffer. Nothing is allocated.
+ */
+int GetParameter(const char* key, char* value, unsigned int len);
+
+bool GetBoolParameter(const char* key, bool def);
+
+template<typename T>
+T GetIntParameter(const char* key, T def, T min = std::numeric_limits<T>::min(),
+    T max = std::numeric_limits<T>::max());
+
+template<typename T>
+T GetUintParameter(const char* key, T def, T max = std::numeric_limits<T>::max());
+
+double GetDoubleParameter(const char* key, double def);
+
+std::optional<std::chrono::milliseconds> GetDurationParameter(const char* key);
+
+std::optional<uint64_t> GetSizeParameter(const char* key);
+
+bool SetParameter(const char* key, const char* value);
+
+int WaitParameter(const char* key, const char* value, int timeout);
+
+unsigned int FindParameter(const char* key);
+
+/*
+ * Calls `visitor` with the key and value of every system parameter whose key starts with `prefix`,
+ * an empty prefix visiting all of them, until it returns false.
+ * Returns the number of parameters visited, or -1 if the parameters can't be listed.
+ * Every key of the workspace is compared with the prefix, there is no index of them, so a visit
+ * costs as much as the whole workspace however few keys match: keep it off frequent paths.
+ */
+int ForEachParameter(const std::string& prefix, const std::function<bool(const char* key, const char* value)>& visitor);
+
+int ForEachParameter(const char* prefix, const std::function<bool(const char* key, const char* value)>& visitor);
+
 unsigned int GetParameterCommitId(unsigned int handle);
 
 std::string GetParameterName(unsigned int handle);
@@ -16,19 +16,78 @@
 #ifndef PARAMETERS_ABSTRACTOR_H
 #define PARAMETERS_ABSTRACTOR_H
 
+#include <cstring>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace OHOS {
 namespace system {
 class ParametersAbstractor {
 public:
     virtual std::string GetParameter(const std::string& key, const std::string& defValue) = 0;
+    virtual std::vector<std::string> GetParameters(const std::vector<std::string>& keys, const std::string& defValue)
+    {
+        std::vector<std::string> values;
+        values.reserve(keys.size());
+        for (const auto& key : keys) {
+            values.push_back(GetParameter(key, defValue));
+        }
+        return values;
+    }
     virtual bool SetParameter(const std::string& key, const std::string& value) = 0;
+    virtual bool SetParameters(const std::vector<std::string>& keys, const std::vector<std::string>& values)
+    {
+        bool ret = true;
+        for (size_t i = 0; i < keys.size(); i++) {
+            ret = SetParameter(keys[i], values[i]) && ret;
+        }
+        return ret;
+    }
     virtual int WaitParameter(const std::string& key, const std::string& value, int timeout) = 0;
     virtual unsigned int FindParameter(const std::string& key) = 0;
     virtual unsigned int GetParameterCommitId(unsigned int handle) = 0;
     virtual std::string GetParameterName(unsigned int handle) = 0;
     virtual std::string GetParameterValue(unsigned int handle) = 0;
+
+    // The overloads on NUL-terminated strings default to the std::string ones, an abstractor reading
+    // the parameters itself overrides them not to allocate.
+    virtual std::string GetParameter(const char* key, const char* defValue)
+    {
+        return GetParameter(std::string(key), std::string(defValue));
+    }
+    virtual int GetParameter(const char* key, char* value, unsigned int len)
+    {
+        std::string result = GetParameter(std::string(key), std::string());
+        if (result.empty()) {
+            return 0;
+        }
+        if (result.size() >= len) {
+            return -1;
+        }
+        (void)memcpy(value, result.c_str(), result.size() + 1);
+        return static_cast<int>(result.size());
+    }
+    virtual bool SetParameter(const char* key, const char* value)
+    {
+        return SetParameter(std::string(key), std::string(value));
+    }
+    virtual int WaitParameter(const char* key, const char* value, int timeout)
+    {
+        return WaitParameter(std::string(key), std::string(value), timeout);
+    }
+    virtual unsigned int FindParameter(const char* key)
+    {
+        return FindParameter(std::string(key));
+    }
+    // Listing the parameters is optional, an abstractor that can't tells it with -1
+    virtual int ForEachParameter(const char* prefix,
+        const std::function<bool(const char* key, const char* value)>& visitor)
+    {
+        (void)prefix;
+        (void)visitor;
+        return -1;
+    }
     virtual ~ParametersAbstractor() {};
 };
 } // namespace system
@@ -16,6 +16,9 @@
 #include "parameters.h"
 
 #include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <unordered_map>
 #include <vector>
 
@@ -25,41 +28,173 @@
 namespace OHOS {
 namespace system {
 namespace {
+#ifdef PARAM_CONST_VALUE_LEN_MAX
+constexpr unsigned int BATCH_VALUE_LEN = PARAM_CONST_VALUE_LEN_MAX;
+#else
+constexpr unsigned int BATCH_VALUE_LEN = PARAM_VALUE_LEN_MAX;
+#endif
+
+/*
+ * Reads a value with a single lookup into a stack buffer that fits any non const value.
+ * Only when that fails for another reason than a missing key is the length probed, a longer
+ * const value then being read straight into the string returned.
+ */
+template<typename Key, typename Reader>
+bool ReadValue(Key key, Reader reader, std::string& out)
+{
+    char buffer[PARAM_VALUE_LEN_MAX] = {0};
+    unsigned int len = sizeof(buffer);
+    int ret = reader(key, buffer, &len);
+    if (ret == 0) {
+        if (buffer[0] == '\0') {
+            return false;
+        }
+        out.assign(buffer);
+        return true;
+    }
+    if (ret == PARAM_CODE_NOT_FOUND) {
+        return false;
+    }
+    len = 0;
+    if ((reader(key, nullptr, &len) != 0) || (len <= sizeof(buffer))) {
+        return false;
+    }
+    out.assign(len + 1, '\0');
+    len = out.size();
+    if (reader(key, &out[0], &len) != 0) {
+        return false;
+    }
+    out.resize(strlen(out.c_str()));
+    return !out.empty();
+}
+
+struct Traversal {
+    const char* prefix;
+    size_t prefixLen;
+    const std::function<bool(const char* key, const char* value)>* visitor;
+    std::string value; // reused by every match, so its storage is allocated once
+    int count;
+    bool stopped;
+};
+
+// The workspace has no way to stop a traversal, the nodes after a stop are skipped by name
+void VisitParameter(ParamHandle handle, void* cookie)
+{
+    Traversal* traversal = static_cast<Traversal*>(cookie);
+    char name[PARAM_NAME_LEN_MAX] = {0};
+    if (traversal->stopped || (SystemGetParameterName(handle, name, sizeof(name)) != 0) ||
+        (strncmp(name, traversal->prefix, traversal->prefixLen) != 0)) {
+        return;
+    }
+    if (!ReadValue(handle, SystemGetParameterValue, traversal->value)) {
+        traversal->value.clear();
+    }
+    traversal->count++;
+    traversal->stopped = !(*traversal->visitor)(name, traversal->value.c_str());
+}
+
 class NullAbstractor : public ParametersAbstractor {
 public:
     std::string GetParameter(const std::string& key, const std::string& def) override
     {
-        unsigned int len = 0;
-        int ret = SystemGetParameter(key.c_str(), nullptr, &len);
-        if (ret == 0 && len > 0) {
-            std::vector<char> value(len + 1);
-            ret = SystemGetParameter(key.c_str(), value.data(), &len);
-            if (ret == 0) {
-                return std::string(value.data());
-            }
+        std::string value;
+        if (ReadValue(key.c_str(), SystemGetParameter, value)) {
+            return value;
         }
         return def;
     }
+
+    std::string GetParameter(const char* key, const char* def) override
+    {
+        std::string value;
+        if (ReadValue(key, SystemGetParameter, value)) {
+            return value;
+        }
+        return def;
+    }
+
+    int GetParameter(const char* key, char* value, unsigned int len) override
+    {
+        unsigned int valueLen = len;
+        int ret = (len > 0) ? SystemGetParameter(key, value, &valueLen) : PARAM_CODE_INVALID_PARAM;
+        if (ret == 0) {
+            return static_cast<int>(strlen(value));
+        }
+        if (ret == PARAM_CODE_NOT_FOUND) {
+            return 0;
+        }
+        // Tell a value too long for the buffer from one that could not be read
+        valueLen = 0;
+        if ((SystemGetParameter(key, nullptr, &valueLen) == 0) && (valueLen > len)) {
+            return -1;
+        }
+        return 0;
+    }
+
+    std::vector<std::string> GetParameters(const std::vector<std::string>& keys, const std::string& def) override
+    {
+        // One buffer large enough for any value, so every key costs a single lookup instead of size + read.
+        std::vector<char> buffer(BATCH_VALUE_LEN);
+        std::vector<std::string> values;
+        values.reserve(keys.size());
+        for (const auto& key : keys) {
+            unsigned int len = BATCH_VALUE_LEN;
+            int ret = SystemGetParameter(key.c_str(), buffer.data(), &len);
+            if (ret == 0 && len > 0) {
+                values.emplace_back(buffer.data());
+            } else {
+                values.push_back(def);
+            }
+        }
+        return values;
+    }
+
     bool SetParameter(const std::string& key, const std::string& value) override
     {
-        return SystemSetParameter(key.c_str(), value.c_str()) == 0;
+        return SetParameter(key.c_str(), value.c_str());
+    }
+
+    bool SetParameter(const char* key, const char* value) override
+    {
+        return SystemSetParameter(key, value) == 0;
     }
 
     int WaitParameter(const std::string& key, const std::string& value, int timeout) override
     {
-        return SystemWaitParameter(key.c_str(), value.c_str(), timeout);
+        return WaitParameter(key.c_str(), value.c_str(), timeout);
+    }
+
+    int WaitParameter(const char* key, const char* value, int timeout) override
+    {
+        return SystemWaitParameter(key, value, timeout);
     }
 
     unsigned int FindParameter(const std::string& key) override
+    {
+        return FindParameter(key.c_str());
+    }
+
+    unsigned int FindParameter(const char* key) override
     {
         unsigned int handle = 0;
-        int ret = SystemFindParameter(key.c_str(), &handle);
+        int ret = SystemFindParameter(key, &handle);
         if (ret != 0) {
             return static_cast<unsigned int>(-1);
         }
         return handle;
     }
 
+    // Only the names are read while walking the workspace, a value is read for the matching keys only
+    int ForEachParameter(const char* prefix,
+        const std::function<bool(const char* key, const char* value)>& visitor) override
+    {
+        Traversal traversal = { prefix, strlen(prefix), &visitor, std::string(), 0, false };
+        if (SystemTraversalParameter(VisitParameter, &traversal) != 0) {
+            return -1;
+        }
+        return traversal.count;
+    }
+
     unsigned int GetParameterCommitId(unsigned int handle) override
     {
         unsigned int commitId = 0;
@@ -82,44 +217,71 @@ public:
 
     std::string GetParameterValue(unsigned int handle) override
     {
-        unsigned int len = 0;
-        int ret = SystemGetParameterValue(handle, nullptr, &len);
-        if (ret == 0 && len > 0) {
-            std::vector<char> value(len + 1);
-            ret = SystemGetParameterValue(handle, value.data(), &len);
-            if (ret == 0) {
-                return std::string(value.data());
-            }
-        }
-        return std::string();
+        std::string value;
+        (void)ReadValue(handle, SystemGetParameterValue, value);
+        return value;
     }
 } g_abstractor;
 
 ParametersAbstractor& g_abstractorRef = g_abstractor;
 
-constexpr unsigned int DECIMAL = 10;
-constexpr unsigned int HEX = 16;
+constexpr int DECIMAL = 10;
+constexpr int HEX = 16;
+constexpr unsigned int INVALID_HANDLE = static_cast<unsigned int>(-1);
+constexpr uint64_t SIZE_UNIT = 1024;
+constexpr int64_t MS_PER_SECOND = 1000;
+constexpr int64_t SECONDS_PER_MINUTE = 60;
+constexpr int64_t MINUTES_PER_HOUR = 60;
 
-template<typename T>
-bool StringToInt(const std::string& str, T min, T max, T& out)
+/*
+ * The numbers are parsed in place with std::from_chars: no copy, no errno and no locale.
+ * They read as strtoll would: leading spaces, then an optional sign, then decimal digits
+ * or hexadecimal ones after "0x", up to the end of the value.
+ */
+const char* SkipSpaces(const char* str)
 {
-    const char* s = str.c_str();
-    while (isspace(*s)) {
-        s++;
+    while (isspace(static_cast<unsigned char>(*str))) {
+        str++;
     }
+    return str;
+}
 
-    bool positiveHex = (str.size() > 1 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'));
-    bool negativeHex = (str.size() > 2 && s[0] == '-' && s[1] == '0' && (s[2] == 'x' || s[2] == 'X')); // 2: shorttest
-    int base = (positiveHex || negativeHex) ? HEX : DECIMAL;
-    char* end = nullptr;
-    errno = 0;
-    long long int result = strtoll(s, &end, base);
-    if (errno != 0) {
+bool ParseMagnitude(const char* begin, const char* end, unsigned long long& magnitude)
+{
+    int base = DECIMAL;
+    if ((end - begin > 2) && (begin[0] == '0') && ((begin[1] == 'x') || (begin[1] == 'X'))) { // 2: "0x"
+        begin += 2; // 2: "0x"
+        base = HEX;
+    }
+    auto result = std::from_chars(begin, end, magnitude, base);
+    return (begin != end) && (result.ec == std::errc()) && (result.ptr == end);
+}
+
+// Splits the optional sign off [begin, end), then parses the digits
+bool ParseSigned(const char* begin, const char* end, bool& negative, unsigned long long& magnitude)
+{
+    negative = (begin != end) && (*begin == '-');
+    if ((begin != end) && ((*begin == '-') || (*begin == '+'))) {
+        begin++;
+    }
+    return ParseMagnitude(begin, end, magnitude);
+}
+
+template<typename T>
+bool StringToInt(const char* str, T min, T max, T& out)
+{
+    const char* begin = SkipSpaces(str);
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if (!ParseSigned(begin, begin + strlen(begin), negative, magnitude)) {
         return false;
     }
-    if (s == end || *end != '\0') {
+    // The magnitude of the smallest long long is one more than that of the largest
+    constexpr unsigned long long largest = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+    if (magnitude > (negative ? largest + 1 : largest)) {
         return false;
     }
+    long long result = negative ? static_cast<long long>(0 - magnitude) : static_cast<long long>(magnitude);
     if (result < min || max < result) {
         return false;
     }
@@ -128,36 +290,227 @@ bool StringToInt(const std::string& str, T min, T max, T& out)
 }
 
 template<typename T>
-bool StringToUint(const std::string& str, T max, T& out)
+bool StringToUint(const char* str, T max, T& out)
+{
+    const char* begin = SkipSpaces(str);
+    bool negative = false;
+    unsigned long long result = 0;
+    if (!ParseSigned(begin, begin + strlen(begin), negative, result) || negative) {
+        return false;
+    }
+    if (max < result) {
+        return false;
+    }
+    out = static_cast<T>(result);
+    return true;
+}
+
+template<typename T>
+bool StringToNumber(const char* str, T& out, std::true_type /* signed */)
+{
+    return StringToInt(str, std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), out);
+}
+
+template<typename T>
+bool StringToNumber(const char* str, T& out, std::false_type /* signed */)
+{
+    return StringToUint(str, std::numeric_limits<T>::max(), out);
+}
+
+// The words are picked by the length of the value, two comparisons at most
+bool StringToBool(const char* value, bool& out)
+{
+    static const char* const trueWords[] = { nullptr, "1y", "on", "yes", "true", nullptr };
+    static const char* const falseWords[] = { nullptr, "0n", "no", "off", nullptr, "false" };
+    size_t len = strlen(value);
+    if ((len == 0) || (len >= sizeof(trueWords) / sizeof(trueWords[0]))) {
+        return false;
+    }
+    if (len == 1) { // the one letter words share their row
+        if (strchr(trueWords[len], value[0]) != nullptr) {
+            out = true;
+            return true;
+        }
+        if (strchr(falseWords[len], value[0]) != nullptr) {
+            out = false;
+            return true;
+        }
+        return false;
+    }
+    if ((trueWords[len] != nullptr) && (strcmp(value, trueWords[len]) == 0)) {
+        out = true;
+        return true;
+    }
+    if ((falseWords[len] != nullptr) && (strcmp(value, falseWords[len]) == 0)) {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+const char* SkipDigits(const char* str, const char* end)
 {
-    const char* s = str.c_str();
-    while (isspace(*s)) {
-        s++;
+    while ((str != end) && isdigit(static_cast<unsigned char>(*str))) {
+        str++;
     }
+    return str;
+}
 
-    if (s[0] == '-') {
+/*
+ * The one grammar both parsers below are held to, whatever else they would take: an optional
+ * sign, decimal digits with an optional fraction, and an optional decimal exponent.
+ * No hexadecimal, infinity nor nan.
+ */
+bool IsDecimalNumber(const char* begin, const char* end)
+{
+    const char* ch = begin;
+    if ((ch != end) && ((*ch == '+') || (*ch == '-'))) {
+        ch++;
+    }
+    const char* integral = ch;
+    ch = SkipDigits(ch, end);
+    bool hasDigits = (ch != integral);
+    if ((ch != end) && (*ch == '.')) {
+        const char* fraction = ++ch;
+        ch = SkipDigits(ch, end);
+        hasDigits = hasDigits || (ch != fraction);
+    }
+    if (!hasDigits) {
         return false;
     }
+    if ((ch != end) && ((*ch == 'e') || (*ch == 'E'))) {
+        ch++;
+        if ((ch != end) && ((*ch == '+') || (*ch == '-'))) {
+            ch++;
+        }
+        const char* exponent = ch;
+        ch = SkipDigits(ch, end);
+        if (ch == exponent) {
+            return false;
+        }
+    }
+    return ch == end;
+}
 
-    int base = (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) ? HEX : DECIMAL;
-    char* end = nullptr;
-    errno = 0;
-    unsigned long long int result = strtoull(s, &end, base);
-    if (errno != 0) {
+bool StringToDouble(const char* str, double& out)
+{
+    const char* begin = SkipSpaces(str);
+    const char* end = begin + strlen(begin);
+    if (!IsDecimalNumber(begin, end)) {
         return false;
     }
-    if (end == s) {
+    double result = 0;
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+    // std::from_chars takes no plus sign, the grammar checked above only lets a digit or a dot follow it
+    auto parsed = std::from_chars((*begin == '+') ? begin + 1 : begin, end, result);
+    if ((parsed.ec != std::errc()) || (parsed.ptr != end)) {
         return false;
     }
-    if (*end != '\0') {
+#else
+    // No floating point std::from_chars in this C++ library
+    char* parsedEnd = nullptr;
+    errno = 0;
+    result = strtod(begin, &parsedEnd);
+    if ((errno != 0) || (parsedEnd == begin) || (parsedEnd != end)) {
         return false;
     }
-    if (max < result) {
+#endif
+    if (!std::isfinite(result)) {
         return false;
     }
-    out = static_cast<T>(result);
+    out = result;
+    return true;
+}
+
+// Splits a number off its unit suffix, the number being a decimal or hexadecimal integer
+bool SplitUnit(const char* str, unsigned long long& number, const char*& unit)
+{
+    const char* begin = SkipSpaces(str);
+    const char* end = begin;
+    if ((end[0] == '0') && ((end[1] == 'x') || (end[1] == 'X'))) {
+        end += 2; // 2: "0x"
+        while (isxdigit(static_cast<unsigned char>(*end))) {
+            end++;
+        }
+    } else {
+        while (isdigit(static_cast<unsigned char>(*end))) {
+            end++;
+        }
+    }
+    unit = end;
+    return ParseMagnitude(begin, end, number);
+}
+
+bool Scale(unsigned long long number, uint64_t factor, uint64_t limit, uint64_t& out)
+{
+    if (number > limit / factor) {
+        return false;
+    }
+    out = number * factor;
     return true;
 }
+
+// "250ms", "30s", "5m" or "1h", milliseconds without unit
+bool StringToDuration(const char* str, std::chrono::milliseconds& out)
+{
+    struct DurationUnit {
+        const char* suffix;
+        uint64_t ms;
+    };
+    static const DurationUnit units[] = {
+        { "", 1 },
+        { "ms", 1 },
+        { "s", MS_PER_SECOND },
+        { "m", MS_PER_SECOND * SECONDS_PER_MINUTE },
+        { "h", MS_PER_SECOND * SECONDS_PER_MINUTE * MINUTES_PER_HOUR },
+    };
+    unsigned long long number = 0;
+    const char* unit = nullptr;
+    if (!SplitUnit(str, number, unit)) {
+        return false;
+    }
+    for (const DurationUnit& candidate : units) {
+        uint64_t ms = 0;
+        if (strcmp(unit, candidate.suffix) == 0) {
+            if (!Scale(number, candidate.ms, std::numeric_limits<std::chrono::milliseconds::rep>::max(), ms)) {
+                return false;
+            }
+            out = std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(ms));
+            return true;
+        }
+    }
+    return false;
+}
+
+// "512", "64K", "16M" or "1G", in bytes, the units being powers of 1024
+bool StringToSize(const char* str, uint64_t& out)
+{
+    static const char units[] = "KMG";
+    unsigned long long number = 0;
+    const char* unit = nullptr;
+    if (!SplitUnit(str, number, unit)) {
+        return false;
+    }
+    if (unit[0] == '\0') {
+        out = number;
+        return true;
+    }
+    const char* found = strchr(units, toupper(static_cast<unsigned char>(unit[0])));
+    if ((found == nullptr) || (unit[1] != '\0')) {
+        return false;
+    }
+    uint64_t factor = SIZE_UNIT;
+    for (const char* u = units; u != found; u++) {
+        factor *= SIZE_UNIT;
+    }
+    return Scale(number, factor, std::numeric_limits<uint64_t>::max(), out);
+}
+
+// The typed getters parse the value straight from a stack buffer, no valid number nor boolean is longer
+bool ReadTypedValue(const char* key, char (&value)[PARAM_VALUE_LEN_MAX])
+{
+    return (key != nullptr) && (g_abstractorRef.GetParameter(key, value, sizeof(value)) > 0);
+}
 }  // namespace
 
 std::string GetParameter(const std::string& key, const std::string& def)
@@ -165,26 +518,57 @@ std::string GetParameter(const std::string& key, const std::string& def)
     return g_abstractorRef.GetParameter(key, def);
 }
 
+std::vector<std::string> GetParameters(const std::vector<std::string>& keys, const std::string& def)
+{
+    return g_abstractorRef.GetParameters(keys, def);
+}
+
+std::string GetParameter(const char* key, const char* def)
+{
+    if (key == nullptr) {
+        return (def == nullptr) ? std::string() : std::string(def);
+    }
+    return g_abstractorRef.GetParameter(key, (def == nullptr) ? "" : def);
+}
+
+int GetParameter(const char* key, char* value, unsigned int len)
+{
+    if ((key == nullptr) || (value == nullptr)) {
+        return -1;
+    }
+    return g_abstractorRef.GetParameter(key, value, len);
+}
+
 bool GetBoolParameter(const std::string& key, bool def)
 {
-    std::string value = GetParameter(key, "");
-    if ((value == "1") || (value == "y") || (value == "yes") || (value == "on") || (value == "true")) {
-        return true;
-    } else if ((value == "0") || (value == "n") || (value == "no") || (value == "off") || (value == "false")) {
-        return false;
+    return GetBoolParameter(key.c_str(), def);
+}
+
+bool GetBoolParameter(const char* key, bool def)
+{
+    char value[PARAM_VALUE_LEN_MAX] = {0};
+    bool result = def;
+    if (ReadTypedValue(key, value) && StringToBool(value, result)) {
+        return result;
     }
     return def;
 }
 
 template<typename T>
 T GetIntParameter(const std::string& key, T def, T min, T max)
+{
+    return GetIntParameter(key.c_str(), def, min, max);
+}
+
+template<typename T>
+T GetIntParameter(const char* key, T def, T min, T max)
 {
     if (!std::is_signed<T>::value) {
         return def;
     }
+    char value[PARAM_VALUE_LEN_MAX] = {0};
     T result;
-    std::string value = GetParameter(key, "");
-    if (!value.empty() && StringToInt(value, min, max, result)) {
+    if (ReadTypedValue(key, value) && StringToInt(value, min, max, result)) {
         return result;
     }
     return def;
@@ -194,16 +578,26 @@ template int8_t GetIntParameter(const std::string&, int8_t, int8_t, int8_t);
 template int16_t GetIntParameter(const std::string&, int16_t, int16_t, int16_t);
 template int32_t GetIntParameter(const std::string&, int32_t, int32_t, int32_t);
 template int64_t GetIntParameter(const std::string&, int64_t, int64_t, int64_t);
+template int8_t GetIntParameter(const char*, int8_t, int8_t, int8_t);
+template int16_t GetIntParameter(const char*, int16_t, int16_t, int16_t);
+template int32_t GetIntParameter(const char*, int32_t, int32_t, int32_t);
+template int64_t GetIntParameter(const char*, int64_t, int64_t, int64_t);
 
 template<typename T>
 T GetUintParameter(const std::string& key, T def, T max)
+{
+    return GetUintParameter(key.c_str(), def, max);
+}
+
+template<typename T>
+T GetUintParameter(const char* key, T def, T max)
 {
     if (!std::is_unsigned<T>::value) {
         return def;
     }
+    char value[PARAM_VALUE_LEN_MAX] = {0};
     T result;
-    std::string value = GetParameter(key, "");
-    if (!value.empty() && StringToUint(value, max, result)) {
+    if (ReadTypedValue(key, value) && StringToUint(value, max, result)) {
         return result;
     }
     return def;
@@ -213,22 +607,156 @@ template uint8_t GetUintParameter(const std::string&, uint8_t, uint8_t);
 template uint16_t GetUintParameter(const std::string&, uint16_t, uint16_t);
 template uint32_t GetUintParameter(const std::string&, uint32_t, uint32_t);
 template uint64_t GetUintParameter(const std::string&, uint64_t, uint64_t);
+template uint8_t GetUintParameter(const char*, uint8_t, uint8_t);
+template uint16_t GetUintParameter(const char*, uint16_t, uint16_t);
+template uint32_t GetUintParameter(const char*, uint32_t, uint32_t);
+template uint64_t GetUintParameter(const char*, uint64_t, uint64_t);
+
+double GetDoubleParameter(const std::string& key, double def)
+{
+    return GetDoubleParameter(key.c_str(), def);
+}
+
+double GetDoubleParameter(const char* key, double def)
+{
+    char value[PARAM_VALUE_LEN_MAX] = {0};
+    double result = def;
+    if (ReadTypedValue(key, value) && StringToDouble(value, result)) {
+        return result;
+    }
+    return def;
+}
+
+std::optional<std::chrono::milliseconds> GetDurationParameter(const std::string& key)
+{
+    return GetDurationParameter(key.c_str());
+}
+
+std::optional<std::chrono::milliseconds> GetDurationParameter(const char* key)
+{
+    char value[PARAM_VALUE_LEN_MAX] = {0};
+    std::chrono::milliseconds result(0);
+    if (ReadTypedValue(key, value) && StringToDuration(value, result)) {
+        return result;
+    }
+    return std::nullopt;
+}
+
+std::optional<uint64_t> GetSizeParameter(const std::string& key)
+{
+    return GetSizeParameter(key.c_str());
+}
+
+std::optional<uint64_t> GetSizeParameter(const char* key)
+{
+    char value[PARAM_VALUE_LEN_MAX] = {0};
+    uint64_t result = 0;
+    if (ReadTypedValue(key, value) && StringToSize(value, result)) {
+        return result;
+    }
+    return std::nullopt;
+}
+
+template<typename T>
+bool ParseParameterValue(const std::string& value, T& out)
+{
+    return !value.empty() && StringToNumber(value.c_str(), out, std::is_signed<T>());
+}
+
+template<>
+bool ParseParameterValue(const std::string& value, bool& out)
+{
+    return StringToBool(value.c_str(), out);
+}
+
+template<>
+bool ParseParameterValue(const std::string& value, double& out)
+{
+    return StringToDouble(value.c_str(), out);
+}
+
+template<>
+bool ParseParameterValue(const std::string& value, std::chrono::milliseconds& out)
+{
+    return StringToDuration(value.c_str(), out);
+}
+
+template<>
+bool ParseParameterValue(const std::string& value, std::string& out)
+{
+    out = value;
+    return true;
+}
+
+template bool ParseParameterValue(const std::string&, int8_t&);
+template bool ParseParameterValue(const std::string&, int16_t&);
+template bool ParseParameterValue(const std::string&, int32_t&);
+template bool ParseParameterValue(const std::string&, int64_t&);
+template bool ParseParameterValue(const std::string&, uint8_t&);
+template bool ParseParameterValue(const std::string&, uint16_t&);
+template bool ParseParameterValue(const std::string&, uint32_t&);
+template bool ParseParameterValue(const std::string&, uint64_t&);
 
 bool SetParameter(const std::string& key, const std::string& value)
 {
     return g_abstractorRef.SetParameter(key, value);
 }
 
+bool SetParameter(const char* key, const char* value)
+{
+    if ((key == nullptr) || (value == nullptr)) {
+        return false;
+    }
+    return g_abstractorRef.SetParameter(key, value);
+}
+
+bool SetParameters(const std::vector<std::string>& keys, const std::vector<std::string>& values)
+{
+    if (keys.empty() || (keys.size() != values.size())) {
+        return false;
+    }
+    return g_abstractorRef.SetParameters(keys, values);
+}
+
 int WaitParameter(const std::string& key, const std::string& value, int timeout)
 {
     return g_abstractorRef.WaitParameter(key, value, timeout);
 }
 
+int WaitParameter(const char* key, const char* value, int timeout)
+{
+    if ((key == nullptr) || (value == nullptr)) {
+        return -1;
+    }
+    return g_abstractorRef.WaitParameter(key, value, timeout);
+}
+
 unsigned int FindParameter(const std::string& key)
 {
     return g_abstractorRef.FindParameter(key);
 }
 
+unsigned int FindParameter(const char* key)
+{
+    if (key == nullptr) {
+        return INVALID_HANDLE;
+    }
+    return g_abstractorRef.FindParameter(key);
+}
+
+int ForEachParameter(const std::string& prefix, const std::function<bool(const char* key, const char* value)>& visitor)
+{
+    return ForEachParameter(prefix.c_str(), visitor);
+}
+
+int ForEachParameter(const char* prefix, const std::function<bool(const char* key, const char* value)>& visitor)
+{
+    if ((prefix == nullptr) || !visitor) {
+        return -1;
+    }
+    return g_abstractorRef.ForEachParameter(prefix, visitor);
+}
+
 unsigned int GetParameterCommitId(unsigned int handle)
 {
     return g_abstractorRef.GetParameterCommitId(handle);
@@ -0,0 +1,146 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Copyright (c) 2021 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generates the header holding the build properties that are known at build time.
+
+The OS full name is composed here rather than at runtime, so the getters hand out
+string literals and never format nor allocate anything.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+VERSION_PATTERN = re.compile(r'^(\d+)\.(\d+)\.(\d+)\.(\d+)$')
+RELEASE = 'Release'
+
+LICENSE = '''/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Generated by gen_build_info.py, do not edit. */
+'''
+
+
+def c_string(value):
+    escaped = []
+    for ch in value:
+        if ch in '\\"':
+            escaped.append('\\' + ch)
+        elif ord(ch) > 0x7F:
+            raise ValueError('non ascii character in "%s"' % value)
+        elif ord(ch) < 0x20 or ord(ch) == 0x7F:
+            escaped.append('\\%03o' % ord(ch))
+        else:
+            escaped.append(ch)
+    return '"%s"' % ''.join(escaped)
+
+
+def os_full_name(os_name, version, release_type):
+    if release_type.startswith(RELEASE):
+        return '%s-%s' % (os_name, version)
+    return '%s-%s(%s)' % (os_name, version, release_type)
+
+
+def generate(args):
+    match = VERSION_PATTERN.match(args.version)
+    if not match:
+        raise ValueError('invalid version "%s", expected major.senior.feature.build' % args.version)
+    if not args.sdk_api_version.isdigit():
+        raise ValueError('invalid sdk api version "%s"' % args.sdk_api_version)
+    major, senior, feature, build = [int(number) for number in match.groups()]
+    version = '%d.%d.%d.%d' % (major, senior, feature, build)
+
+    strings = [
+        ('OHOS_OS_NAME', args.os_name),
+        ('OHOS_RELEASE_TYPE', args.release_type),
+        ('OHOS_SECURITY_PATCH_TAG', args.security_patch),
+        ('OHOS_OS_FULL_NAME', os_full_name(args.os_name, version, args.release_type)),
+        ('INCREMENTAL_VERSION', args.incremental_version),
+        ('BUILD_TYPE', args.build_type),
+        ('BUILD_USER', args.build_user),
+        ('BUILD_TIME', args.build_time),
+        ('BUILD_HOST', args.build_host),
+        ('BUILD_ROOTHASH', args.build_roothash),
+    ]
+    numbers = [
+        ('OHOS_SDK_API_VERSION', int(args.sdk_api_version)),
+        ('MAJOR_VERSION', major),
+        ('SENIOR_VERSION', senior),
+        ('FEATURE_VERSION', feature),
+        ('BUILD_VERSION', build),
+    ]
+    lines = [LICENSE]
+    lines.append('#ifndef OHOS_BUILD_INFO_H\n#define OHOS_BUILD_INFO_H\n\n')
+    for name, value in numbers:
+        lines.append('#define %s %d\n' % (name, value))
+    lines.append('\n')
+    for name, value in strings:
+        lines.append('#define %s %s\n' % (name, c_string(value)))
+    lines.append('\n#endif  // OHOS_BUILD_INFO_H\n')
+    return ''.join(lines)
+
+
+def write_file(path, content):
+    directory = os.path.dirname(path)
+    if directory and not os.path.exists(directory):
+        os.makedirs(directory)
+    # Left untouched when unchanged, not to rebuild every dependent for nothing
+    if os.path.exists(path):
+        with open(path, 'r') as current:
+            if current.read() == content:
+                return
+    with open(path, 'w') as output:
+        output.write(content)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--output', required=True, help='output, the build info header')
+    parser.add_argument('--os-name', required=True)
+    parser.add_argument('--version', required=True, help='major.senior.feature.build')
+    parser.add_argument('--release-type', required=True)
+    parser.add_argument('--security-patch', required=True)
+    parser.add_argument('--sdk-api-version', required=True)
+    parser.add_argument('--incremental-version', default='')
+    parser.add_argument('--build-type', default='')
+    parser.add_argument('--build-user', default='')
+    parser.add_argument('--build-time', default='')
+    parser.add_argument('--build-host', default='')
+    parser.add_argument('--build-roothash', default='')
+    args = parser.parse_args(argv)
+
+    try:
+        write_file(args.output, generate(args))
+    except (IOError, ValueError) as error:
+        sys.stderr.write('gen_build_info.py: %s\n' % error)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -17,6 +17,7 @@
 #define IOT_SYSPARA_API_H
 
 #include "ohos_types.h"
+#include "parameter.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -24,12 +25,37 @@ extern "C" {
 #endif
 #endif /* __cplusplus */
 
+#ifndef DATA_PATH
+#ifndef __LITEOS_M__
+#define DATA_PATH          "/storage/data/system/param/"
+#else
+#define DATA_PATH          ""
+#endif
+#endif
+
 #define MAX_GET_VALUE_LEN  0x7FFFFFFF
 #define MAX_KEY_LEN 32
 #define MAX_VALUE_LEN 128
 
 int GetSysParam(const char* key, char* value, unsigned int len);
 int SetSysParam(const char* key, const char* value);
+/* Resolves every item in one pass, storing the GetSysParam result of each one in its ret */
+int GetSysParams(ParameterItem* items, unsigned int count);
+/* Stores every key or none of them, committed to the storage once where the backend allows it */
+int SetSysParams(const char** keys, const char** values, unsigned int count);
+/* Blocks until key holds value, "*" matching any value, or until timeout seconds passed when it is positive */
+int WaitSysParam(const char* key, const char* value, int timeout);
+/* Calls callback whenever a key starting with keyPrefix is stored, a NULL callback cancels the watch of context */
+int WatchSysParam(const char* keyPrefix, ParameterChgPtr callback, void* context);
+/* Calls visitor with every stored key starting with prefix until it returns non zero, returns how many it was given */
+int ForEachSysParam(const char* prefix, ParameterVisitor visitor, void* context);
+/* Names a stored key with a handle that stays valid for the life of the process */
+int FindSysParam(const char* key, unsigned int* handle);
+/* Moves on whenever the key of handle is stored, sample it before reading the value */
+int GetSysParamCommitId(unsigned int handle, unsigned int* commitId);
+int GetSysParamName(unsigned int handle, char* key, unsigned int len);
+/* Moves on with every store of a key starting with prefix if it ends with a dot, of key prefix otherwise */
+int GetSysParamSequence(const char* prefix, unsigned int* seq);
 boolean CheckPermission(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,769 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <securec.h>
+#include <stdint.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_seq.h"
+#include "param_txn.h"
+
+#define SYS_UID_INDEX      1000
+
+/*
+ * All parameters live in one page aligned file: a fixed header followed by an open addressing
+ * slot table. Parameter keys are lower case only, so the upper case file names can never
+ * collide with a key stored by the per-file backend in the same directory.
+ */
+#define ARENA_FILE         DATA_PATH "PARAM_ARENA"
+#define ARENA_TEMP_FILE    DATA_PATH "PARAM_ARENA.TMP"
+#define ARENA_TXN_FILE     DATA_PATH "PARAM_ARENA.TXN"
+#define ARENA_MAGIC        0x50415241
+#define ARENA_VERSION      1
+#ifndef ARENA_SLOT_COUNT
+#define ARENA_SLOT_COUNT   512
+#endif
+#if ARENA_SLOT_COUNT > UINT16_MAX
+#error "the key index of the arena numbers slots in 16 bits"
+#endif
+#define ARENA_READ_RETRY   1000
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t keyCount;
+    uint32_t batchSerial; /* odd while SetSysParams is applying a batch */
+    uint32_t reserved[2];
+} ArenaHeader;
+
+typedef struct {
+    uint32_t serial; /* odd while the slot is being written */
+    uint32_t valueLen;
+    char key[MAX_KEY_LEN];
+    char value[MAX_VALUE_LEN];
+} ArenaSlot;
+
+typedef struct {
+    int fd;
+    boolean writable;
+    size_t mapSize;
+    ArenaHeader *header;
+    ArenaSlot *slots;
+    pthread_mutex_t lock;
+    pthread_mutex_t indexLock; /* not the writer lock, which waits for the writers of other processes */
+    uint32_t indexedKeys; /* key count of the arena the last time the index was brought up to date */
+    uint32_t sortedCount;
+    uint16_t sorted[ARENA_SLOT_COUNT]; /* the slots holding a key, in the order of their keys */
+} ParamArena;
+
+static ParamArena g_arena = {
+    .fd = -1,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .indexLock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static boolean IsValidChar(const char ch)
+{
+    if (islower(ch) || isdigit(ch) || (ch == '_') || (ch == '.')) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static boolean IsValidValue(const char* value, unsigned int len)
+{
+    if ((value == NULL) || !strlen(value) || (strlen(value) >= len)) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static boolean IsValidKey(const char* key)
+{
+    if (!IsValidValue(key, MAX_KEY_LEN)) {
+        return FALSE;
+    }
+    int keyLen = strlen(key);
+    for (int i = 0; i < keyLen; i++) {
+        if (!IsValidChar(key[i])) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static boolean IsValidPrefix(const char* prefix)
+{
+    if ((prefix == NULL) || (strlen(prefix) >= MAX_KEY_LEN)) {
+        return FALSE;
+    }
+    for (const char* ch = prefix; *ch != '\0'; ch++) {
+        if (!IsValidChar(*ch)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static uint32_t HashKey(const char* key)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static size_t ArenaMapSize(void)
+{
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = sizeof(ArenaHeader) + sizeof(ArenaSlot) * ARENA_SLOT_COUNT;
+    return (size + pageSize - 1) / pageSize * pageSize;
+}
+
+static boolean IsValidArena(const ArenaHeader* header)
+{
+    return (header->magic == ARENA_MAGIC) && (header->version == ARENA_VERSION) &&
+        (header->slotCount == ARENA_SLOT_COUNT) && (header->slotSize == sizeof(ArenaSlot));
+}
+
+/* Must be called with the arena locked, returns the slot holding key or the free slot to claim. */
+static ArenaSlot* ProbeSlot(ArenaSlot* slots, const char* key)
+{
+    uint32_t index = HashKey(key) % ARENA_SLOT_COUNT;
+    for (uint32_t i = 0; i < ARENA_SLOT_COUNT; i++) {
+        ArenaSlot* slot = &slots[(index + i) % ARENA_SLOT_COUNT];
+        if ((slot->key[0] == '\0') || (strncmp(slot->key, key, MAX_KEY_LEN) == 0)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static int WriteSlot(ArenaHeader* header, ArenaSlot* slots, const char* key, const char* value)
+{
+    ArenaSlot* slot = ProbeSlot(slots, key);
+    if (slot == NULL) {
+        return EC_FAILURE;
+    }
+    boolean isNew = (slot->key[0] == '\0');
+    uint32_t serial = slot->serial & ~1U; /* a writer died holding the slot, the lock is ours now */
+    __atomic_store_n(&slot->serial, serial + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    int ret = EC_SUCCESS;
+    if (isNew && (strcpy_s(slot->key, MAX_KEY_LEN, key) != 0)) {
+        ret = EC_FAILURE;
+    } else if (strcpy_s(slot->value, MAX_VALUE_LEN, value) != 0) {
+        ret = EC_FAILURE;
+    } else {
+        slot->valueLen = (uint32_t)strlen(value);
+    }
+    __atomic_store_n(&slot->serial, serial + 2, __ATOMIC_RELEASE); /* 2: back to an even serial */
+    if (isNew && (ret == EC_SUCCESS)) {
+        header->keyCount++;
+    }
+    if (ret == EC_SUCCESS) {
+        ParamSeqBump(key);
+    }
+    return ret;
+}
+
+static void InitArenaHeader(ArenaHeader* header)
+{
+    header->magic = ARENA_MAGIC;
+    header->version = ARENA_VERSION;
+    header->slotCount = ARENA_SLOT_COUNT;
+    header->slotSize = sizeof(ArenaSlot);
+    header->keyCount = 0;
+    header->batchSerial = 0;
+}
+
+static int ReadLegacyValue(int dirFd, const char* key, char* value, unsigned int len)
+{
+    int fd = openat(dirFd, key, O_RDONLY);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    ssize_t ret = read(fd, value, len - 1);
+    close(fd);
+    if (ret <= 0) {
+        return EC_FAILURE;
+    }
+    value[ret] = '\0';
+    return EC_SUCCESS;
+}
+
+/* Imports every key written by the per-file backend, run once when the arena does not exist yet. */
+static void MigrateLegacyParams(ArenaHeader* header, ArenaSlot* slots)
+{
+    DIR* dir = opendir(DATA_PATH);
+    if (dir == NULL) {
+        return;
+    }
+    char value[MAX_VALUE_LEN] = {0};
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0) ||
+            !IsValidKey(entry->d_name)) {
+            continue;
+        }
+        if (ReadLegacyValue(dirfd(dir), entry->d_name, value, sizeof(value)) == EC_SUCCESS) {
+            (void)WriteSlot(header, slots, entry->d_name, value);
+        }
+    }
+    closedir(dir);
+}
+
+static int CreateArena(size_t mapSize)
+{
+    int fd = open(ARENA_TEMP_FILE, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    /* Another process may be migrating concurrently, the loser simply reuses its result. */
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    if (access(ARENA_FILE, F_OK) == 0) {
+        (void)unlink(ARENA_TEMP_FILE);
+        close(fd);
+        return EC_SUCCESS;
+    }
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)mapSize) != 0) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    void* addr = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    ArenaHeader* header = (ArenaHeader *)addr;
+    InitArenaHeader(header);
+    MigrateLegacyParams(header, (ArenaSlot *)(header + 1));
+    int ret = msync(addr, mapSize, MS_SYNC);
+    munmap(addr, mapSize);
+    if ((ret == 0) && (fsync(fd) == 0) && (rename(ARENA_TEMP_FILE, ARENA_FILE) == 0)) {
+        ret = EC_SUCCESS;
+    } else {
+        ret = EC_FAILURE;
+    }
+    close(fd);
+    return ret;
+}
+
+static int MapArena(size_t mapSize)
+{
+    boolean writable = TRUE;
+    int fd = open(ARENA_FILE, O_RDWR);
+    if ((fd < 0) && (errno == EACCES)) {
+        writable = FALSE;
+        fd = open(ARENA_FILE, O_RDONLY);
+    }
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    struct stat info = {0};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    if ((size_t)info.st_size < mapSize) {
+        /* Laid out for fewer slots, rebuilt like any other unknown layout */
+        close(fd);
+        return EC_INVALID;
+    }
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* addr = mmap(NULL, mapSize, prot, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    if (!IsValidArena((ArenaHeader *)addr)) {
+        munmap(addr, mapSize);
+        close(fd);
+        return EC_INVALID;
+    }
+    g_arena.fd = fd;
+    g_arena.writable = writable;
+    g_arena.mapSize = mapSize;
+    g_arena.slots = (ArenaSlot *)((ArenaHeader *)addr + 1);
+    __atomic_store_n(&g_arena.header, (ArenaHeader *)addr, __ATOMIC_RELEASE);
+    return EC_SUCCESS;
+}
+
+static int ApplyLoggedParam(const char* key, const char* value, void* context)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    ParamArena* arena = (ParamArena *)context;
+    return WriteSlot(arena->header, arena->slots, key, value);
+}
+
+/* Must be called with the arena locked, finishes a batch whose writer died after committing it. */
+static void RecoverBatch(ParamArena* arena)
+{
+    ArenaHeader* header = arena->header;
+    boolean committed = (access(ARENA_TXN_FILE, F_OK) == 0);
+    if (!committed && ((header->batchSerial & 1) == 0)) {
+        return;
+    }
+    uint32_t serial = header->batchSerial | 1U;
+    __atomic_store_n(&header->batchSerial, serial, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    int ret = committed ? ParamTxnLogReplay(ARENA_TXN_FILE, ApplyLoggedParam, arena) : EC_FAILURE;
+    __atomic_store_n(&header->batchSerial, serial + 1, __ATOMIC_RELEASE);
+    if (ret == EC_SUCCESS) {
+        (void)msync(header, arena->mapSize, MS_SYNC);
+    }
+    if (committed) {
+        ParamTxnLogClear(ARENA_TXN_FILE);
+    }
+}
+
+static void InitArena(void)
+{
+    size_t mapSize = ArenaMapSize();
+    int ret = MapArena(mapSize);
+    if (ret == EC_INVALID && CheckPermission()) {
+        /* Unknown layout, rebuild from the per-file parameters */
+        (void)unlink(ARENA_FILE);
+    }
+    if (ret != EC_SUCCESS && CreateArena(mapSize) == EC_SUCCESS) {
+        ret = MapArena(mapSize);
+    }
+    if ((ret == EC_SUCCESS) && g_arena.writable && (flock(g_arena.fd, LOCK_EX) == 0)) {
+        RecoverBatch(&g_arena);
+        (void)flock(g_arena.fd, LOCK_UN);
+    }
+}
+
+/* Keeps retrying until the arena exists, an unprivileged reader may start before it is created */
+static ParamArena* GetArena(void)
+{
+    if (__atomic_load_n(&g_arena.header, __ATOMIC_ACQUIRE) != NULL) {
+        return &g_arena;
+    }
+    (void)pthread_mutex_lock(&g_arena.lock);
+    if (g_arena.header == NULL) {
+        InitArena();
+    }
+    (void)pthread_mutex_unlock(&g_arena.lock);
+    return (g_arena.header != NULL) ? &g_arena : NULL;
+}
+
+/*
+ * Lock free read, retried while a writer holds the slot.
+ * Returns FALSE when the slot belongs to another key and probing has to go on.
+ */
+static boolean ReadSlot(const ArenaSlot* slot, const char* key, char* value, unsigned int len, int* ret)
+{
+    for (int retry = 0; retry < ARENA_READ_RETRY; retry++) {
+        uint32_t serial = __atomic_load_n(&slot->serial, __ATOMIC_ACQUIRE);
+        if ((serial & 1) != 0) {
+            (void)sched_yield();
+            continue;
+        }
+        boolean found = TRUE;
+        uint32_t valueLen = slot->valueLen;
+        if (slot->key[0] == '\0') {
+            *ret = EC_FAILURE;
+        } else if (strncmp(slot->key, key, MAX_KEY_LEN) != 0) {
+            found = FALSE;
+        } else if ((valueLen >= len) || (valueLen >= MAX_VALUE_LEN)) {
+            *ret = EC_INVALID;
+        } else {
+            (void)memcpy_s(value, len, slot->value, valueLen);
+            *ret = (int)valueLen;
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->serial, __ATOMIC_RELAXED) == serial) {
+            return found;
+        }
+    }
+    *ret = EC_FAILURE;
+    return TRUE;
+}
+
+/* Lock free copy of a whole slot, FALSE when it holds no key */
+static boolean CopySlot(const ArenaSlot* slot, char* key, char* value)
+{
+    for (int retry = 0; retry < ARENA_READ_RETRY; retry++) {
+        uint32_t serial = __atomic_load_n(&slot->serial, __ATOMIC_ACQUIRE);
+        if ((serial & 1) != 0) {
+            (void)sched_yield();
+            continue;
+        }
+        uint32_t valueLen = slot->valueLen;
+        boolean used = (slot->key[0] != '\0') && (valueLen < MAX_VALUE_LEN);
+        if (used) {
+            (void)memcpy_s(key, MAX_KEY_LEN, slot->key, MAX_KEY_LEN);
+            (void)memcpy_s(value, MAX_VALUE_LEN, slot->value, valueLen);
+            key[MAX_KEY_LEN - 1] = '\0';
+            value[valueLen] = '\0';
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->serial, __ATOMIC_RELAXED) == serial) {
+            return used;
+        }
+    }
+    return FALSE;
+}
+
+/* Lock free check for a key in the slot, once there it never changes */
+static boolean SlotHasKey(const ArenaSlot* slot)
+{
+    for (int retry = 0; retry < ARENA_READ_RETRY; retry++) {
+        uint32_t serial = __atomic_load_n(&slot->serial, __ATOMIC_ACQUIRE);
+        if ((serial & 1) != 0) {
+            (void)sched_yield();
+            continue;
+        }
+        boolean used = (slot->key[0] != '\0');
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->serial, __ATOMIC_RELAXED) == serial) {
+            return used;
+        }
+    }
+    return FALSE;
+}
+
+/* Must be called with the index locked, the first position whose key is not below key, or is above it with after */
+static uint32_t SearchIndex(const ParamArena* arena, const char* key, boolean after)
+{
+    uint32_t low = 0;
+    uint32_t high = arena->sortedCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int cmp = strncmp(arena->slots[arena->sorted[mid]].key, key, MAX_KEY_LEN);
+        if ((cmp < 0) || (after && (cmp == 0))) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/*
+ * Must be called with the index locked. Keys are only ever added to the arena, by any process,
+ * so the index is only brought up to date when the key count has moved, merging in the new ones.
+ */
+static void RefreshIndex(ParamArena* arena)
+{
+    uint32_t keyCount = __atomic_load_n(&arena->header->keyCount, __ATOMIC_ACQUIRE);
+    if (keyCount == arena->indexedKeys) {
+        return;
+    }
+    for (uint32_t i = 0; (i < ARENA_SLOT_COUNT) && (arena->sortedCount < ARENA_SLOT_COUNT); i++) {
+        const ArenaSlot* slot = &arena->slots[i];
+        if (!SlotHasKey(slot)) {
+            continue;
+        }
+        uint32_t pos = SearchIndex(arena, slot->key, FALSE);
+        if ((pos < arena->sortedCount) && (arena->sorted[pos] == i)) {
+            continue;
+        }
+        (void)memmove_s(&arena->sorted[pos + 1], (ARENA_SLOT_COUNT - pos - 1) * sizeof(uint16_t),
+            &arena->sorted[pos], (arena->sortedCount - pos) * sizeof(uint16_t));
+        arena->sorted[pos] = (uint16_t)i;
+        arena->sortedCount++;
+    }
+    arena->indexedKeys = keyCount;
+}
+
+/* The slot of the first key from on, or past it when after is set, NULL once the index runs out */
+static const ArenaSlot* NextIndexedSlot(ParamArena* arena, const char* from, boolean after)
+{
+    (void)pthread_mutex_lock(&arena->indexLock);
+    RefreshIndex(arena);
+    uint32_t pos = SearchIndex(arena, from, after);
+    const ArenaSlot* slot = (pos < arena->sortedCount) ? &arena->slots[arena->sorted[pos]] : NULL;
+    (void)pthread_mutex_unlock(&arena->indexLock);
+    return slot;
+}
+
+int GetSysParam(const char* key, char* value, unsigned int len)
+{
+    if (!IsValidKey(key) || (value == NULL) || (len > MAX_GET_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    ParamArena* arena = GetArena();
+    if (arena == NULL) {
+        return EC_FAILURE;
+    }
+    int ret = EC_FAILURE;
+    uint32_t index = HashKey(key) % ARENA_SLOT_COUNT;
+    for (uint32_t i = 0; i < ARENA_SLOT_COUNT; i++) {
+        if (ReadSlot(&arena->slots[(index + i) % ARENA_SLOT_COUNT], key, value, len, &ret)) {
+            break;
+        }
+    }
+    if (ret >= 0) {
+        value[ret] = '\0';
+    }
+    return ret;
+}
+
+/*
+ * Must be called with the arena and its file locked, a batch still open now belongs to a dead writer.
+ * A reader that may not write can not finish it and reads what the writer left.
+ */
+static void ReadBatchLocked(ParamArena* arena, ParameterItem* items, unsigned int count)
+{
+    if (arena->writable && ((arena->header->batchSerial & 1) != 0)) {
+        RecoverBatch(arena);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        items[i].ret = GetSysParam(items[i].key, items[i].value, items[i].len);
+    }
+}
+
+/*
+ * Lookups never leave the mapping, the batch is simply read again if SetSysParams ran meanwhile.
+ * A batch that stays open is waited for on the writer locks, so a writer that was only preempted
+ * still gets all or nothing read.
+ */
+int GetSysParams(ParameterItem* items, unsigned int count)
+{
+    ParamArena* arena = GetArena();
+    for (int retry = 0; retry < ARENA_READ_RETRY; retry++) {
+        uint32_t serial = (arena != NULL) ? __atomic_load_n(&arena->header->batchSerial, __ATOMIC_ACQUIRE) : 0;
+        if ((serial & 1) != 0) {
+            (void)sched_yield();
+            continue;
+        }
+        for (unsigned int i = 0; i < count; i++) {
+            items[i].ret = GetSysParam(items[i].key, items[i].value, items[i].len);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if ((arena == NULL) || (__atomic_load_n(&arena->header->batchSerial, __ATOMIC_RELAXED) == serial)) {
+            return EC_SUCCESS;
+        }
+    }
+    /* flock only serializes processes, the mutex keeps out the writers of this one */
+    (void)pthread_mutex_lock(&arena->lock);
+    int lock = arena->writable ? LOCK_EX : LOCK_SH;
+    if (flock(arena->fd, lock) != 0) {
+        (void)pthread_mutex_unlock(&arena->lock);
+        return EC_FAILURE;
+    }
+    ReadBatchLocked(arena, items, count);
+    (void)flock(arena->fd, LOCK_UN);
+    (void)pthread_mutex_unlock(&arena->lock);
+    return EC_SUCCESS;
+}
+
+int SetSysParam(const char* key, const char* value)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    ParamArena* arena = GetArena();
+    if ((arena == NULL) || !arena->writable) {
+        return EC_FAILURE;
+    }
+    /* flock only serializes processes, threads sharing the fd need the mutex as well */
+    (void)pthread_mutex_lock(&arena->lock);
+    if (flock(arena->fd, LOCK_EX) != 0) {
+        (void)pthread_mutex_unlock(&arena->lock);
+        return EC_FAILURE;
+    }
+    if ((arena->header->batchSerial & 1) != 0) {
+        RecoverBatch(arena);
+    }
+    int ret = WriteSlot(arena->header, arena->slots, key, value);
+    (void)flock(arena->fd, LOCK_UN);
+    (void)pthread_mutex_unlock(&arena->lock);
+    return ret;
+}
+
+/* Must be called with the arena locked, TRUE when every key of the batch has a slot */
+static boolean HasRoomFor(ParamArena* arena, const char** keys, unsigned int count)
+{
+    uint32_t newKeys = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        ArenaSlot* slot = ProbeSlot(arena->slots, keys[i]);
+        if (slot == NULL) {
+            return FALSE;
+        }
+        newKeys += (slot->key[0] == '\0') ? 1 : 0;
+    }
+    return (arena->header->keyCount + newKeys) <= ARENA_SLOT_COUNT;
+}
+
+int SetSysParams(const char** keys, const char** values, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        if (!IsValidKey(keys[i]) || !IsValidValue(values[i], MAX_VALUE_LEN)) {
+            return EC_INVALID;
+        }
+    }
+    ParamArena* arena = GetArena();
+    if ((arena == NULL) || !arena->writable) {
+        return EC_FAILURE;
+    }
+    (void)pthread_mutex_lock(&arena->lock);
+    if (flock(arena->fd, LOCK_EX) != 0) {
+        (void)pthread_mutex_unlock(&arena->lock);
+        return EC_FAILURE;
+    }
+    if ((arena->header->batchSerial & 1) != 0) {
+        RecoverBatch(arena);
+    }
+    int ret = HasRoomFor(arena, keys, count) ? EC_SUCCESS : EC_FAILURE;
+    if (ret == EC_SUCCESS) {
+        /* The log write is the commit point, a crash after it is finished by RecoverBatch */
+        ret = ParamTxnLogWrite(ARENA_TXN_FILE, keys, values, count);
+    }
+    if (ret == EC_SUCCESS) {
+        ArenaHeader* header = arena->header;
+        uint32_t serial = header->batchSerial;
+        __atomic_store_n(&header->batchSerial, serial + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        for (unsigned int i = 0; (ret == EC_SUCCESS) && (i < count); i++) {
+            ret = WriteSlot(header, arena->slots, keys[i], values[i]);
+        }
+        /* A committed batch is rolled forward, never left half applied */
+        if (ret != EC_SUCCESS) {
+            ret = ParamTxnLogReplay(ARENA_TXN_FILE, ApplyLoggedParam, arena);
+        }
+        __atomic_store_n(&header->batchSerial, serial + 2, __ATOMIC_RELEASE); /* 2: back to an even serial */
+        /*
+         * One flush of the mapping for the whole batch, the log can only go once it is done.
+         * A log kept after a failed flush only replays what readers already see.
+         */
+        if ((ret != EC_SUCCESS) || (msync(header, arena->mapSize, MS_SYNC) == 0)) {
+            ParamTxnLogClear(ARENA_TXN_FILE);
+        }
+    }
+    (void)flock(arena->fd, LOCK_UN);
+    (void)pthread_mutex_unlock(&arena->lock);
+    return ret;
+}
+
+int WaitSysParam(const char* key, const char* value, int timeout)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    return ParamSeqWait(key, value, timeout, GetSysParam);
+}
+
+/*
+ * Slots are placed by hash, the index of this process keeps them in key order, so the walk starts
+ * at the prefix and ends with the last key under it. Each step looks up the key after the last one
+ * visited, values are copied straight from the mapping, so a visitor may get or set parameters itself.
+ */
+int ForEachSysParam(const char* prefix, ParameterVisitor visitor, void* context)
+{
+    if (!IsValidPrefix(prefix) || (visitor == NULL)) {
+        return EC_INVALID;
+    }
+    ParamArena* arena = GetArena();
+    if (arena == NULL) {
+        return EC_FAILURE;
+    }
+    size_t prefixLen = strlen(prefix);
+    char key[MAX_KEY_LEN] = {0};
+    char value[MAX_VALUE_LEN] = {0};
+    int count = 0;
+    const ArenaSlot* slot = NextIndexedSlot(arena, prefix, FALSE);
+    while ((slot != NULL) && (strncmp(slot->key, prefix, prefixLen) == 0)) {
+        if (CopySlot(slot, key, value)) {
+            count++;
+            if (visitor(key, value, context) != 0) {
+                break;
+            }
+        }
+        slot = NextIndexedSlot(arena, slot->key, TRUE);
+    }
+    return count;
+}
+
+/* Changes are only observed through the files of the per-key storage */
+int WatchSysParam(const char* keyPrefix, ParameterChgPtr callback, void* context)
+{
+    if (!IsValidKey(keyPrefix)) {
+        return EC_INVALID;
+    }
+    (void)callback;
+    (void)context;
+    return EC_FAILURE;
+}
+
+/* Commit ids come from the sequence table every store of the arena bumps */
+int FindSysParam(const char* key, unsigned int* handle)
+{
+    if (!IsValidKey(key) || (handle == NULL)) {
+        return EC_INVALID;
+    }
+    char value[MAX_VALUE_LEN] = {0};
+    if (GetSysParam(key, value, sizeof(value)) < 0) {
+        return EC_FAILURE;
+    }
+    return ParamSeqFind(key, handle);
+}
+
+int GetSysParamCommitId(unsigned int handle, unsigned int* commitId)
+{
+    if (commitId == NULL) {
+        return EC_INVALID;
+    }
+    return ParamSeqCommitId(handle, commitId);
+}
+
+int GetSysParamName(unsigned int handle, char* key, unsigned int len)
+{
+    if (key == NULL) {
+        return EC_INVALID;
+    }
+    return ParamSeqName(handle, key, len);
+}
+
+int GetSysParamSequence(const char* prefix, unsigned int* seq)
+{
+    if (!IsValidPrefix(prefix) || (seq == NULL)) {
+        return EC_INVALID;
+    }
+    return ParamSeqGet(prefix, seq);
+}
+
+boolean CheckPermission(void)
+{
+    uid_t uid = getuid();
+    if (uid <= SYS_UID_INDEX) {
+        return TRUE;
+    }
+    return FALSE;
+}
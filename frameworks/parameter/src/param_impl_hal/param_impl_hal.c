@@ -76,6 +76,14 @@ int GetSysParam(const char* key, char* value, unsigned int len)
     return valueLen;
 }
 
+int GetSysParams(ParameterItem* items, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        items[i].ret = GetSysParam(items[i].key, items[i].value, items[i].len);
+    }
+    return EC_SUCCESS;
+}
+
 int SetSysParam(const char* key, const char* value)
 {
     if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
@@ -92,6 +100,81 @@ int SetSysParam(const char* key, const char* value)
     return (ret < 0) ? EC_FAILURE : EC_SUCCESS;
 }
 
+/* The utils file API has neither rename nor sync, a batch is validated as a whole and then stored key by key */
+int SetSysParams(const char** keys, const char** values, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        if (!IsValidKey(keys[i]) || !IsValidValue(values[i], MAX_VALUE_LEN)) {
+            return EC_INVALID;
+        }
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        int ret = SetSysParam(keys[i], values[i]);
+        if (ret != EC_SUCCESS) {
+            return ret;
+        }
+    }
+    return EC_SUCCESS;
+}
+
+/* Nothing tells a waiter that another task stored a value, waiting is not supported here */
+int WaitSysParam(const char* key, const char* value, int timeout)
+{
+    (void)key;
+    (void)value;
+    (void)timeout;
+    return EC_FAILURE;
+}
+
+int WatchSysParam(const char* keyPrefix, ParameterChgPtr callback, void* context)
+{
+    if (!IsValidKey(keyPrefix)) {
+        return EC_INVALID;
+    }
+    (void)callback;
+    (void)context;
+    return EC_FAILURE;
+}
+
+/* The utils file API has no way to list the stored files */
+int ForEachSysParam(const char* prefix, ParameterVisitor visitor, void* context)
+{
+    (void)prefix;
+    (void)visitor;
+    (void)context;
+    return EC_FAILURE;
+}
+
+/* Nothing is shared between the tasks that store values, so no commit id can be kept */
+int FindSysParam(const char* key, unsigned int* handle)
+{
+    (void)key;
+    (void)handle;
+    return EC_FAILURE;
+}
+
+int GetSysParamCommitId(unsigned int handle, unsigned int* commitId)
+{
+    (void)handle;
+    (void)commitId;
+    return EC_FAILURE;
+}
+
+int GetSysParamName(unsigned int handle, char* key, unsigned int len)
+{
+    (void)handle;
+    (void)key;
+    (void)len;
+    return EC_FAILURE;
+}
+
+int GetSysParamSequence(const char* prefix, unsigned int* seq)
+{
+    (void)prefix;
+    (void)seq;
+    return EC_FAILURE;
+}
+
 boolean CheckPermission(void)
 {
     return TRUE;
@@ -0,0 +1,857 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <securec.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_seq.h"
+
+#define SYS_UID_INDEX      1000
+
+/*
+ * Every SetSysParam appends one record to a log instead of rewriting a file, each process
+ * keeps an index of the live values and follows the tail of the log written by the others.
+ * Once the log has grown well past its live records it is compacted into a new log, and
+ * the old one is sealed so that its readers switch over. Upper case names can never collide
+ * with a key stored by the per-file backend in the same directory.
+ */
+#define JOURNAL_FILE       DATA_PATH "PARAM_JOURNAL"
+#define JOURNAL_TEMP_FILE  DATA_PATH "PARAM_JOURNAL.TMP"
+#define JOURNAL_MAGIC      0x504A524E
+#define JOURNAL_VERSION    1
+#ifndef JOURNAL_INDEX_SIZE
+#define JOURNAL_INDEX_SIZE 512
+#endif
+#if JOURNAL_INDEX_SIZE > UINT16_MAX
+#error "the key order of the journal numbers entries in 16 bits"
+#endif
+#ifndef JOURNAL_COMPACT_THRESHOLD
+#define JOURNAL_COMPACT_THRESHOLD (32 * 1024)
+#endif
+#define JOURNAL_WINDOW_SIZE 4096
+#define CRC32_POLY         0xEDB88320U
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+
+#define RECORD_FLAG_SEAL   0x1 /* last record of a log that compaction replaced */
+#define RECORD_FLAG_BATCH  0x2 /* more records of the same SetSysParams batch follow */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+} JournalHeader;
+
+typedef struct {
+    uint32_t crc; /* CRC-32 of the rest of the record, key and value included */
+    uint32_t seq;
+    uint8_t keyLen;
+    uint8_t valueLen;
+    uint16_t flags;
+} JournalRecord;
+
+#define MAX_RECORD_SIZE    (sizeof(JournalRecord) + MAX_KEY_LEN + MAX_VALUE_LEN)
+
+typedef enum {
+    RECORD_OK,
+    RECORD_SEALED,
+    RECORD_INCOMPLETE,
+    RECORD_CORRUPT,
+} RecordStatus;
+
+typedef struct {
+    uint32_t seq;
+    uint32_t valueLen;
+    char key[MAX_KEY_LEN];
+    char value[MAX_VALUE_LEN];
+} JournalEntry;
+
+typedef struct {
+    int fd;
+    boolean writable;
+    off_t offset; /* the index reflects every record before it */
+    uint32_t seq;
+    uint32_t keyCount;
+    off_t liveSize; /* size the log would have with the live records only */
+    JournalEntry *entries;
+    uint16_t *sorted; /* the keyCount entries holding a key, in the order of their keys */
+    off_t windowOffset;
+    size_t windowLen;
+    char window[JOURNAL_WINDOW_SIZE];
+    boolean compactPending;
+    boolean compactorStarted;
+    boolean compacting; /* the compactor holds the log lock for the writers of this process */
+    pthread_mutex_t lock;
+    pthread_cond_t compactCond;
+} ParamJournal;
+
+static ParamJournal g_journal = {
+    .fd = -1,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .compactCond = PTHREAD_COND_INITIALIZER,
+};
+
+static boolean IsValidChar(const char ch)
+{
+    if (islower(ch) || isdigit(ch) || (ch == '_') || (ch == '.')) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static boolean IsValidValue(const char* value, unsigned int len)
+{
+    if ((value == NULL) || !strlen(value) || (strlen(value) >= len)) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static boolean IsValidKey(const char* key)
+{
+    if (!IsValidValue(key, MAX_KEY_LEN)) {
+        return FALSE;
+    }
+    int keyLen = strlen(key);
+    for (int i = 0; i < keyLen; i++) {
+        if (!IsValidChar(key[i])) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static boolean IsValidPrefix(const char* prefix)
+{
+    if ((prefix == NULL) || (strlen(prefix) >= MAX_KEY_LEN)) {
+        return FALSE;
+    }
+    for (const char* ch = prefix; *ch != '\0'; ch++) {
+        if (!IsValidChar(*ch)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static uint32_t HashKey(const char* key)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t Crc32(uint32_t crc, const char* data, size_t len)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (unsigned char)data[i];
+        for (int bit = 0; bit < 8; bit++) { /* 8: bits per byte */
+            crc = (crc >> 1) ^ (CRC32_POLY & (0U - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t RecordCrc(const JournalRecord* record, const char* payload)
+{
+    uint32_t crc = Crc32(0, (const char *)record + sizeof(record->crc), sizeof(JournalRecord) - sizeof(record->crc));
+    return Crc32(crc, payload, record->keyLen + record->valueLen);
+}
+
+static size_t RecordSize(const JournalRecord* record)
+{
+    return sizeof(JournalRecord) + record->keyLen + record->valueLen;
+}
+
+/* Serializes one record into buffer, which must hold MAX_RECORD_SIZE bytes */
+static size_t BuildRecord(char* buffer, uint32_t seq, uint16_t flags, const char* key, const char* value)
+{
+    JournalRecord record = { 0, seq, (uint8_t)strlen(key), (uint8_t)strlen(value), flags };
+    char* payload = buffer + sizeof(JournalRecord);
+    (void)memcpy_s(payload, MAX_KEY_LEN + MAX_VALUE_LEN, key, record.keyLen);
+    (void)memcpy_s(payload + record.keyLen, MAX_VALUE_LEN, value, record.valueLen);
+    record.crc = RecordCrc(&record, payload);
+    (void)memcpy_s(buffer, sizeof(JournalRecord), &record, sizeof(JournalRecord));
+    return RecordSize(&record);
+}
+
+static JournalEntry* ProbeEntry(JournalEntry* entries, const char* key, size_t keyLen)
+{
+    char name[MAX_KEY_LEN] = {0};
+    if ((keyLen >= MAX_KEY_LEN) || (memcpy_s(name, sizeof(name), key, keyLen) != 0)) {
+        return NULL;
+    }
+    uint32_t index = HashKey(name) % JOURNAL_INDEX_SIZE;
+    for (uint32_t i = 0; i < JOURNAL_INDEX_SIZE; i++) {
+        JournalEntry* entry = &entries[(index + i) % JOURNAL_INDEX_SIZE];
+        if ((entry->key[0] == '\0') || (strcmp(entry->key, name) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void ResetIndex(ParamJournal* journal)
+{
+    (void)memset_s(journal->entries, sizeof(JournalEntry) * JOURNAL_INDEX_SIZE, 0,
+        sizeof(JournalEntry) * JOURNAL_INDEX_SIZE);
+    journal->offset = sizeof(JournalHeader);
+    journal->liveSize = sizeof(JournalHeader);
+    journal->keyCount = 0;
+    journal->windowLen = 0;
+}
+
+/* Must be called with the journal locked, the first position in key order whose key is not below key */
+static uint32_t SearchSorted(const ParamJournal* journal, const char* key)
+{
+    uint32_t low = 0;
+    uint32_t high = journal->keyCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (strncmp(journal->entries[journal->sorted[mid]].key, key, MAX_KEY_LEN) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void SortNewEntry(ParamJournal* journal, const JournalEntry* entry)
+{
+    uint32_t pos = SearchSorted(journal, entry->key);
+    (void)memmove_s(&journal->sorted[pos + 1], (JOURNAL_INDEX_SIZE - pos - 1) * sizeof(uint16_t),
+        &journal->sorted[pos], (journal->keyCount - pos) * sizeof(uint16_t));
+    journal->sorted[pos] = (uint16_t)(entry - journal->entries);
+}
+
+static void IndexRecord(ParamJournal* journal, const JournalRecord* record, const char* payload)
+{
+    journal->seq = (record->seq > journal->seq) ? record->seq : journal->seq;
+    JournalEntry* entry = ProbeEntry(journal->entries, payload, record->keyLen);
+    if (entry == NULL) {
+        return;
+    }
+    if (entry->key[0] == '\0') {
+        (void)memcpy_s(entry->key, MAX_KEY_LEN, payload, record->keyLen);
+        SortNewEntry(journal, entry);
+        journal->keyCount++;
+        journal->liveSize += (off_t)RecordSize(record);
+    } else {
+        journal->liveSize += (off_t)record->valueLen - (off_t)entry->valueLen;
+    }
+    (void)memcpy_s(entry->value, MAX_VALUE_LEN, payload + record->keyLen, record->valueLen);
+    entry->value[record->valueLen] = '\0';
+    entry->valueLen = record->valueLen;
+    entry->seq = record->seq;
+}
+
+/* Returns how many bytes starting at offset are available in the read window, refilling it if needed */
+static size_t ReadWindow(ParamJournal* journal, off_t offset, size_t len)
+{
+    if ((offset < journal->windowOffset) || (offset + (off_t)len > journal->windowOffset + (off_t)journal->windowLen)) {
+        ssize_t ret = pread(journal->fd, journal->window, sizeof(journal->window), offset);
+        journal->windowOffset = offset;
+        journal->windowLen = (ret > 0) ? (size_t)ret : 0;
+    }
+    size_t available = journal->windowLen - (size_t)(offset - journal->windowOffset);
+    return (available < len) ? available : len;
+}
+
+static RecordStatus ParseRecord(ParamJournal* journal, off_t offset, JournalRecord* record, const char** payload)
+{
+    if (ReadWindow(journal, offset, sizeof(JournalRecord)) < sizeof(JournalRecord)) {
+        return RECORD_INCOMPLETE;
+    }
+    (void)memcpy_s(record, sizeof(JournalRecord), journal->window + (offset - journal->windowOffset),
+        sizeof(JournalRecord));
+    if ((record->keyLen >= MAX_KEY_LEN) || (record->valueLen >= MAX_VALUE_LEN)) {
+        return RECORD_CORRUPT;
+    }
+    size_t size = RecordSize(record);
+    if (ReadWindow(journal, offset, size) < size) {
+        return RECORD_INCOMPLETE;
+    }
+    *payload = journal->window + (offset - journal->windowOffset) + sizeof(JournalRecord);
+    if (RecordCrc(record, *payload) != record->crc) {
+        return RECORD_CORRUPT;
+    }
+    if ((record->flags & RECORD_FLAG_SEAL) != 0) {
+        return RECORD_SEALED;
+    }
+    return (record->keyLen > 0) ? RECORD_OK : RECORD_CORRUPT;
+}
+
+/*
+ * Brings the index up to date with records appended since the last call. A batch is only indexed
+ * once its last record is in, so readers see all of it or none of it. With repair set, the caller
+ * holds the log exclusively, so a record that is still incomplete was torn by a dead writer.
+ */
+static RecordStatus FollowJournal(ParamJournal* journal, boolean repair)
+{
+    struct stat info = {0};
+    if (fstat(journal->fd, &info) != 0) {
+        return RECORD_CORRUPT;
+    }
+    RecordStatus status = RECORD_OK;
+    JournalRecord record;
+    const char* payload = NULL;
+    off_t offset = journal->offset;
+    while (offset < info.st_size) {
+        status = ParseRecord(journal, offset, &record, &payload);
+        if (status != RECORD_OK) {
+            break;
+        }
+        offset += (off_t)RecordSize(&record);
+        if ((record.flags & RECORD_FLAG_BATCH) != 0) {
+            continue;
+        }
+        /* Last record of a batch, index it from its first record on */
+        for (off_t next = journal->offset; next < offset; next += (off_t)RecordSize(&record)) {
+            (void)ParseRecord(journal, next, &record, &payload);
+            IndexRecord(journal, &record, payload);
+        }
+        journal->offset = offset;
+    }
+    if (status == RECORD_SEALED) {
+        return status;
+    }
+    if (journal->offset < info.st_size) {
+        /* Never trust the window past the indexed records, the tail may be rewritten after a repair */
+        journal->windowLen = 0;
+        if (repair) {
+            (void)ftruncate(journal->fd, journal->offset);
+        }
+    }
+    return RECORD_OK;
+}
+
+static int WriteAll(int fd, const char* data, size_t size, off_t offset)
+{
+    while (size > 0) {
+        ssize_t ret = pwrite(fd, data, size, offset);
+        if (ret <= 0) {
+            return EC_FAILURE;
+        }
+        data += ret;
+        offset += ret;
+        size -= (size_t)ret;
+    }
+    return EC_SUCCESS;
+}
+
+static int ReadLegacyValue(int dirFd, const char* key, char* value, unsigned int len)
+{
+    int fd = openat(dirFd, key, O_RDONLY);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    ssize_t ret = read(fd, value, len - 1);
+    close(fd);
+    if (ret <= 0) {
+        return EC_FAILURE;
+    }
+    value[ret] = '\0';
+    return EC_SUCCESS;
+}
+
+/* Starts a new log holding every key written by the per-file backend, so switching storage keeps them. */
+static int InitJournalFile(int fd)
+{
+    JournalHeader header = { JOURNAL_MAGIC, JOURNAL_VERSION };
+    if ((ftruncate(fd, 0) != 0) || (WriteAll(fd, (const char *)&header, sizeof(header), 0) != EC_SUCCESS)) {
+        return EC_FAILURE;
+    }
+    DIR* dir = opendir(DATA_PATH);
+    if (dir == NULL) {
+        return EC_SUCCESS;
+    }
+    off_t offset = sizeof(header);
+    uint32_t seq = 0;
+    char record[MAX_RECORD_SIZE];
+    char value[MAX_VALUE_LEN] = {0};
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!IsValidKey(entry->d_name) ||
+            (ReadLegacyValue(dirfd(dir), entry->d_name, value, sizeof(value)) != EC_SUCCESS)) {
+            continue;
+        }
+        size_t size = BuildRecord(record, ++seq, 0, entry->d_name, value);
+        if (WriteAll(fd, record, size, offset) != EC_SUCCESS) {
+            break;
+        }
+        offset += (off_t)size;
+    }
+    closedir(dir);
+    return EC_SUCCESS;
+}
+
+static int OpenJournal(ParamJournal* journal)
+{
+    boolean writable = TRUE;
+    int fd = open(JOURNAL_FILE, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if ((fd < 0) && (errno == EACCES)) {
+        writable = FALSE;
+        fd = open(JOURNAL_FILE, O_RDONLY | O_CLOEXEC);
+    }
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    JournalHeader header = {0};
+    boolean valid = (pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)) &&
+        (header.magic == JOURNAL_MAGIC) && (header.version == JOURNAL_VERSION);
+    if (!valid && writable && (flock(fd, LOCK_EX) == 0)) {
+        /* Created just now, or an unknown layout: start over, unless another process already did */
+        valid = (pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)) &&
+            (header.magic == JOURNAL_MAGIC) && (header.version == JOURNAL_VERSION);
+        if (!valid) {
+            valid = (InitJournalFile(fd) == EC_SUCCESS);
+        }
+        (void)flock(fd, LOCK_UN);
+    }
+    if (!valid) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    journal->fd = fd;
+    journal->writable = writable;
+    ResetIndex(journal);
+    return EC_SUCCESS;
+}
+
+/* Must be called with the journal locked, follows the log across compactions */
+static int SyncJournal(ParamJournal* journal, boolean repair)
+{
+    while (FollowJournal(journal, repair) == RECORD_SEALED) {
+        if (repair) {
+            (void)flock(journal->fd, LOCK_UN);
+        }
+        close(journal->fd);
+        journal->fd = -1;
+        if (OpenJournal(journal) != EC_SUCCESS) {
+            return EC_FAILURE;
+        }
+        if (repair && (flock(journal->fd, LOCK_EX) != 0)) {
+            return EC_FAILURE;
+        }
+    }
+    return EC_SUCCESS;
+}
+
+/* Must be called with the journal locked, opens the log the first time a parameter is accessed */
+static ParamJournal* GetJournal(void)
+{
+    ParamJournal* journal = &g_journal;
+    if (journal->entries == NULL) {
+        journal->entries = (JournalEntry *)calloc(JOURNAL_INDEX_SIZE, sizeof(JournalEntry));
+        if (journal->entries == NULL) {
+            return NULL;
+        }
+    }
+    if (journal->sorted == NULL) {
+        journal->sorted = (uint16_t *)calloc(JOURNAL_INDEX_SIZE, sizeof(uint16_t));
+        if (journal->sorted == NULL) {
+            return NULL;
+        }
+    }
+    if ((journal->fd < 0) && (OpenJournal(journal) != EC_SUCCESS)) {
+        return NULL;
+    }
+    return journal;
+}
+
+/* Must be called with the journal and the log locked, serializes the live records of the index */
+static char* SnapshotJournal(const ParamJournal* journal, size_t* size)
+{
+    char* buffer = (char *)malloc((size_t)journal->liveSize);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    JournalHeader header = { JOURNAL_MAGIC, JOURNAL_VERSION };
+    (void)memcpy_s(buffer, (size_t)journal->liveSize, &header, sizeof(header));
+    *size = sizeof(header);
+    for (uint32_t i = 0; i < JOURNAL_INDEX_SIZE; i++) {
+        const JournalEntry* entry = &journal->entries[i];
+        if (entry->key[0] == '\0') {
+            continue;
+        }
+        char record[MAX_RECORD_SIZE];
+        size_t len = BuildRecord(record, entry->seq, 0, entry->key, entry->value);
+        if (memcpy_s(buffer + *size, (size_t)journal->liveSize - *size, record, len) != 0) {
+            free(buffer);
+            return NULL;
+        }
+        *size += len;
+    }
+    return buffer;
+}
+
+/* Must be called with the journal locked, copies the records appended since the snapshot as they are */
+static int CopyTail(const ParamJournal* journal, int fd, off_t from, off_t to)
+{
+    char chunk[JOURNAL_WINDOW_SIZE];
+    off_t offset = lseek(fd, 0, SEEK_END);
+    while ((offset >= 0) && (from < to)) {
+        size_t len = ((to - from) < (off_t)sizeof(chunk)) ? (size_t)(to - from) : sizeof(chunk);
+        ssize_t ret = pread(journal->fd, chunk, len, from);
+        if ((ret <= 0) || (WriteAll(fd, chunk, (size_t)ret, offset) != EC_SUCCESS)) {
+            return EC_FAILURE;
+        }
+        from += ret;
+        offset += ret;
+    }
+    return (offset >= 0) ? EC_SUCCESS : EC_FAILURE;
+}
+
+/*
+ * Must be called with the journal and the log locked, rewrites the live records into a new log.
+ * The new log is written and flushed with the journal unlocked, so that the getters and setters
+ * of this process go on meanwhile. The log lock stays held against the other processes, the
+ * records appended by this process in between are copied over before the switch.
+ */
+static void CompactJournal(ParamJournal* journal)
+{
+    size_t size = 0;
+    char* buffer = SnapshotJournal(journal, &size);
+    if (buffer == NULL) {
+        return;
+    }
+    off_t snapshotOffset = journal->offset;
+    journal->compacting = TRUE;
+    (void)pthread_mutex_unlock(&journal->lock);
+    int fd = open(JOURNAL_TEMP_FILE, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    int ret = (fd >= 0) ? WriteAll(fd, buffer, size, 0) : EC_FAILURE;
+    free(buffer);
+    if ((ret == EC_SUCCESS) && (fsync(fd) != 0)) {
+        ret = EC_FAILURE;
+    }
+    (void)pthread_mutex_lock(&journal->lock);
+    journal->compacting = FALSE;
+    if ((ret == EC_SUCCESS) && (journal->offset > snapshotOffset)) {
+        ret = CopyTail(journal, fd, snapshotOffset, journal->offset);
+        if ((ret == EC_SUCCESS) && (fsync(fd) != 0)) {
+            ret = EC_FAILURE;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if ((ret != EC_SUCCESS) || (rename(JOURNAL_TEMP_FILE, JOURNAL_FILE) != 0)) {
+        (void)unlink(JOURNAL_TEMP_FILE);
+        return;
+    }
+    /* The appends to the new log are only as durable as its name, which is flushed before any of them */
+    int dirFd = open(DATA_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        (void)fsync(dirFd);
+        close(dirFd);
+    }
+    /* Everybody still holding the old log switches over when they reach the seal */
+    char seal[MAX_RECORD_SIZE];
+    size = BuildRecord(seal, journal->seq, RECORD_FLAG_SEAL, "", "");
+    (void)WriteAll(journal->fd, seal, size, journal->offset);
+}
+
+static void* CompactorThread(void* arg)
+{
+    ParamJournal* journal = (ParamJournal *)arg;
+    (void)pthread_mutex_lock(&journal->lock);
+    while (1) {
+        while (!journal->compactPending) {
+            (void)pthread_cond_wait(&journal->compactCond, &journal->lock);
+        }
+        journal->compactPending = FALSE;
+        if ((journal->fd < 0) || (flock(journal->fd, LOCK_EX) != 0)) {
+            continue;
+        }
+        /* Another process may have compacted already */
+        if ((SyncJournal(journal, TRUE) == EC_SUCCESS) && (journal->offset >= JOURNAL_COMPACT_THRESHOLD) &&
+            (journal->offset >= journal->liveSize * 2)) { /* 2: at least half of the log is garbage */
+            CompactJournal(journal);
+        }
+        if (journal->fd >= 0) {
+            (void)flock(journal->fd, LOCK_UN);
+        }
+        (void)SyncJournal(journal, FALSE);
+    }
+    return NULL;
+}
+
+/* Must be called with the journal locked, compaction runs off the writer's path */
+static void RequestCompaction(ParamJournal* journal)
+{
+    if ((journal->offset < JOURNAL_COMPACT_THRESHOLD) || (journal->offset < journal->liveSize * 2)) {
+        return;
+    }
+    if (!journal->compactorStarted) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, CompactorThread, journal) != 0) {
+            return;
+        }
+        (void)pthread_detach(thread);
+        journal->compactorStarted = TRUE;
+    }
+    journal->compactPending = TRUE;
+    (void)pthread_cond_signal(&journal->compactCond);
+}
+
+static int AppendRecords(const char** keys, const char** values, unsigned int count)
+{
+    /* A batch never holds more keys than the index, which also bounds the buffer below */
+    if ((count == 0) || (count > JOURNAL_INDEX_SIZE)) {
+        return EC_INVALID;
+    }
+    char* buffer = (char *)malloc(MAX_RECORD_SIZE * count);
+    if (buffer == NULL) {
+        return EC_FAILURE;
+    }
+    (void)pthread_mutex_lock(&g_journal.lock);
+    ParamJournal* journal = GetJournal();
+    /* flock belongs to the open log, while the compactor holds it the writers of this process share it */
+    boolean locked = (journal != NULL) && journal->compacting;
+    if ((journal == NULL) || !journal->writable || (!locked && (flock(journal->fd, LOCK_EX) != 0))) {
+        (void)pthread_mutex_unlock(&g_journal.lock);
+        free(buffer);
+        return EC_FAILURE;
+    }
+    int ret = SyncJournal(journal, TRUE);
+    uint32_t newKeys = 0;
+    for (unsigned int i = 0; (ret == EC_SUCCESS) && (i < count); i++) {
+        JournalEntry* entry = ProbeEntry(journal->entries, keys[i], strlen(keys[i]));
+        newKeys += ((entry != NULL) && (entry->key[0] == '\0')) ? 1 : 0;
+        ret = (entry != NULL) ? EC_SUCCESS : EC_FAILURE;
+    }
+    if ((ret == EC_SUCCESS) && (journal->keyCount + newKeys > JOURNAL_INDEX_SIZE)) {
+        ret = EC_FAILURE;
+    }
+    size_t size = 0;
+    for (unsigned int i = 0; (ret == EC_SUCCESS) && (i < count); i++) {
+        uint16_t flags = (i + 1 < count) ? RECORD_FLAG_BATCH : 0;
+        size += BuildRecord(buffer + size, journal->seq + i + 1, flags, keys[i], values[i]);
+    }
+    /*
+     * One write and one flush for the whole batch, which is committed once both are done.
+     * A crash in the middle of them leaves a torn tail that is dropped.
+     */
+    if ((ret == EC_SUCCESS) && ((WriteAll(journal->fd, buffer, size, journal->offset) != EC_SUCCESS) ||
+        (fdatasync(journal->fd) != 0))) {
+        (void)ftruncate(journal->fd, journal->offset);
+        ret = EC_FAILURE;
+    }
+    if (ret == EC_SUCCESS) {
+        (void)FollowJournal(journal, FALSE);
+    }
+    if ((journal->fd >= 0) && !locked) {
+        (void)flock(journal->fd, LOCK_UN);
+    }
+    if (ret == EC_SUCCESS) {
+        RequestCompaction(journal);
+    }
+    (void)pthread_mutex_unlock(&g_journal.lock);
+    free(buffer);
+    for (unsigned int i = 0; (ret == EC_SUCCESS) && (i < count); i++) {
+        ParamSeqBump(keys[i]);
+    }
+    return ret;
+}
+
+/* Must be called with the journal locked */
+static int LookupEntry(ParamJournal* journal, const char* key, char* value, unsigned int len)
+{
+    JournalEntry* entry = ProbeEntry(journal->entries, key, strlen(key));
+    if ((entry == NULL) || (entry->key[0] == '\0')) {
+        return EC_FAILURE;
+    }
+    if (entry->valueLen >= len) {
+        return EC_INVALID;
+    }
+    if (memcpy_s(value, len, entry->value, entry->valueLen + 1) != 0) {
+        return EC_FAILURE;
+    }
+    return (int)entry->valueLen;
+}
+
+int GetSysParam(const char* key, char* value, unsigned int len)
+{
+    if (!IsValidKey(key) || (value == NULL) || (len > MAX_GET_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    int ret = EC_FAILURE;
+    (void)pthread_mutex_lock(&g_journal.lock);
+    ParamJournal* journal = GetJournal();
+    if ((journal != NULL) && (SyncJournal(journal, FALSE) == EC_SUCCESS)) {
+        ret = LookupEntry(journal, key, value, len);
+    }
+    (void)pthread_mutex_unlock(&g_journal.lock);
+    return ret;
+}
+
+/* The whole batch is served from one state of the index */
+int GetSysParams(ParameterItem* items, unsigned int count)
+{
+    (void)pthread_mutex_lock(&g_journal.lock);
+    ParamJournal* journal = GetJournal();
+    if ((journal != NULL) && (SyncJournal(journal, FALSE) != EC_SUCCESS)) {
+        journal = NULL;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        ParameterItem* item = &items[i];
+        if (!IsValidKey(item->key) || (item->value == NULL) || (item->len > MAX_GET_VALUE_LEN)) {
+            item->ret = EC_INVALID;
+        } else {
+            item->ret = (journal != NULL) ? LookupEntry(journal, item->key, item->value, item->len) : EC_FAILURE;
+        }
+    }
+    (void)pthread_mutex_unlock(&g_journal.lock);
+    return EC_SUCCESS;
+}
+
+int SetSysParam(const char* key, const char* value)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    return AppendRecords(&key, &value, 1);
+}
+
+int SetSysParams(const char** keys, const char** values, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        if (!IsValidKey(keys[i]) || !IsValidValue(values[i], MAX_VALUE_LEN)) {
+            return EC_INVALID;
+        }
+    }
+    return AppendRecords(keys, values, count);
+}
+
+int WaitSysParam(const char* key, const char* value, int timeout)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    return ParamSeqWait(key, value, timeout, GetSysParam);
+}
+
+/*
+ * The keys under the prefix are a range of the key order that starts at a binary search.
+ * The matches are copied out of the index first, so a visitor may get or set parameters itself.
+ */
+int ForEachSysParam(const char* prefix, ParameterVisitor visitor, void* context)
+{
+    if (!IsValidPrefix(prefix) || (visitor == NULL)) {
+        return EC_INVALID;
+    }
+    size_t prefixLen = strlen(prefix);
+    JournalEntry* matches = NULL;
+    int count = EC_FAILURE;
+    (void)pthread_mutex_lock(&g_journal.lock);
+    ParamJournal* journal = GetJournal();
+    if ((journal != NULL) && (SyncJournal(journal, FALSE) == EC_SUCCESS)) {
+        uint32_t first = SearchSorted(journal, prefix);
+        uint32_t last = first;
+        while ((last < journal->keyCount) &&
+            (strncmp(journal->entries[journal->sorted[last]].key, prefix, prefixLen) == 0)) {
+            last++;
+        }
+        if (last > first) {
+            matches = (JournalEntry *)malloc((last - first) * sizeof(JournalEntry));
+        }
+        count = ((matches != NULL) || (last == first)) ? 0 : EC_NOMEMORY;
+        for (uint32_t i = first; (matches != NULL) && (i < last); i++) {
+            matches[count++] = journal->entries[journal->sorted[i]];
+        }
+    }
+    (void)pthread_mutex_unlock(&g_journal.lock);
+    int visited = 0;
+    while (visited < count) {
+        const JournalEntry* entry = &matches[visited++];
+        if (visitor(entry->key, entry->value, context) != 0) {
+            break;
+        }
+    }
+    free(matches);
+    return (count < 0) ? count : visited;
+}
+
+/* Changes are only observed through the files of the per-key storage */
+int WatchSysParam(const char* keyPrefix, ParameterChgPtr callback, void* context)
+{
+    if (!IsValidKey(keyPrefix)) {
+        return EC_INVALID;
+    }
+    (void)callback;
+    (void)context;
+    return EC_FAILURE;
+}
+
+/* Commit ids come from the sequence table every commit of the journal bumps */
+int FindSysParam(const char* key, unsigned int* handle)
+{
+    if (!IsValidKey(key) || (handle == NULL)) {
+        return EC_INVALID;
+    }
+    char value[MAX_VALUE_LEN] = {0};
+    if (GetSysParam(key, value, sizeof(value)) < 0) {
+        return EC_FAILURE;
+    }
+    return ParamSeqFind(key, handle);
+}
+
+int GetSysParamCommitId(unsigned int handle, unsigned int* commitId)
+{
+    if (commitId == NULL) {
+        return EC_INVALID;
+    }
+    return ParamSeqCommitId(handle, commitId);
+}
+
+int GetSysParamName(unsigned int handle, char* key, unsigned int len)
+{
+    if (key == NULL) {
+        return EC_INVALID;
+    }
+    return ParamSeqName(handle, key, len);
+}
+
+int GetSysParamSequence(const char* prefix, unsigned int* seq)
+{
+    if (!IsValidPrefix(prefix) || (seq == NULL)) {
+        return EC_INVALID;
+    }
+    return ParamSeqGet(prefix, seq);
+}
+
+boolean CheckPermission(void)
+{
+    uid_t uid = getuid();
+    if (uid <= SYS_UID_INDEX) {
+        return TRUE;
+    }
+    return FALSE;
+}
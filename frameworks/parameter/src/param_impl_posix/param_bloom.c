@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_bloom.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_monitor.h"
+
+/* 8192 bits and 4 probes keep false positives around 0.1% for a few hundred keys */
+#define BLOOM_BITS         8192
+#define BLOOM_WORD_BITS    32
+#define BLOOM_PROBES       4
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+#define DJB_SEED           5381U
+#define DJB_SHIFT          5
+
+typedef struct {
+    boolean enabled;
+    uint32_t bits[BLOOM_BITS / BLOOM_WORD_BITS];
+    ParamBloomStats stats;
+} ParamBloom;
+
+static ParamBloom g_bloom = { FALSE, { 0 }, { 0, 0, 0 } };
+static pthread_once_t g_bloomOnce = PTHREAD_ONCE_INIT;
+
+static void GetKeyHashes(const char* key, uint32_t* first, uint32_t* second)
+{
+    uint32_t fnv = FNV_OFFSET_BASIS;
+    uint32_t djb = DJB_SEED;
+    for (const char* ch = key; *ch != '\0'; ch++) {
+        fnv = (fnv ^ (unsigned char)*ch) * FNV_PRIME;
+        djb = ((djb << DJB_SHIFT) + djb) + (unsigned char)*ch;
+    }
+    *first = fnv;
+    *second = djb | 1;
+}
+
+static void AddKey(const char* key)
+{
+    uint32_t first = 0;
+    uint32_t second = 0;
+    GetKeyHashes(key, &first, &second);
+    for (uint32_t i = 0; i < BLOOM_PROBES; i++) {
+        uint32_t bit = (first + i * second) % BLOOM_BITS;
+        (void)__atomic_fetch_or(&g_bloom.bits[bit / BLOOM_WORD_BITS], 1U << (bit % BLOOM_WORD_BITS),
+            __ATOMIC_RELEASE);
+    }
+}
+
+static void ScanParamDir(void)
+{
+    DIR* dir = opendir(DATA_PATH);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        AddKey(entry->d_name);
+    }
+    closedir(dir);
+}
+
+/* Keys are never removed from the filter, a deleted key only costs a false positive */
+static void OnParamChanged(const char* key)
+{
+    if (key == NULL) {
+        ScanParamDir();
+    } else {
+        AddKey(key);
+    }
+}
+
+static void InitBloom(void)
+{
+    /* Watch before scanning so that no file created in between is missed */
+    if (ParamMonitorAddListener(OnParamChanged, PARAM_EVENT_ALL) != EC_SUCCESS) {
+        return;
+    }
+    ScanParamDir();
+    __atomic_store_n(&g_bloom.enabled, TRUE, __ATOMIC_RELEASE);
+}
+
+boolean ParamBloomMayContain(const char* key)
+{
+    (void)pthread_once(&g_bloomOnce, InitBloom);
+    if (!__atomic_load_n(&g_bloom.enabled, __ATOMIC_ACQUIRE) || !ParamMonitorIsRunning()) {
+        return TRUE;
+    }
+    (void)__atomic_add_fetch(&g_bloom.stats.lookups, 1, __ATOMIC_RELAXED);
+    uint32_t first = 0;
+    uint32_t second = 0;
+    GetKeyHashes(key, &first, &second);
+    for (uint32_t i = 0; i < BLOOM_PROBES; i++) {
+        uint32_t bit = (first + i * second) % BLOOM_BITS;
+        uint32_t word = __atomic_load_n(&g_bloom.bits[bit / BLOOM_WORD_BITS], __ATOMIC_ACQUIRE);
+        if ((word & (1U << (bit % BLOOM_WORD_BITS))) == 0) {
+            (void)__atomic_add_fetch(&g_bloom.stats.negativeHits, 1, __ATOMIC_RELAXED);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+void ParamBloomAdd(const char* key)
+{
+    AddKey(key);
+}
+
+void ParamBloomReportFalsePositive(void)
+{
+    if (__atomic_load_n(&g_bloom.enabled, __ATOMIC_ACQUIRE)) {
+        (void)__atomic_add_fetch(&g_bloom.stats.falsePositives, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void ParamBloomGetStats(ParamBloomStats* stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    stats->lookups = __atomic_load_n(&g_bloom.stats.lookups, __ATOMIC_RELAXED);
+    stats->negativeHits = __atomic_load_n(&g_bloom.stats.negativeHits, __ATOMIC_RELAXED);
+    stats->falsePositives = __atomic_load_n(&g_bloom.stats.falsePositives, __ATOMIC_RELAXED);
+}
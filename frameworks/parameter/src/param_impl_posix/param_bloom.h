@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_BLOOM_H
+#define PARAM_BLOOM_H
+
+#include "ohos_types.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+typedef struct {
+    unsigned int lookups;        /* keys checked against the filter */
+    unsigned int negativeHits;   /* misses answered without touching the file system */
+    unsigned int falsePositives; /* keys let through by the filter that did not exist */
+} ParamBloomStats;
+
+/*
+ * Returns FALSE only if key has never been stored. Always TRUE when the filter
+ * could not be built or kept current, so callers fall back to the file system.
+ */
+boolean ParamBloomMayContain(const char* key);
+
+void ParamBloomAdd(const char* key);
+
+/* Records that a key let through by the filter was not found. */
+void ParamBloomReportFalsePositive(void);
+
+/* Counters since the process started, checked by ParamPosixTest and for debugging */
+void ParamBloomGetStats(ParamBloomStats* stats);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_BLOOM_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_cache.h"
+
+#include <pthread.h>
+#include <securec.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_monitor.h"
+
+/* Direct mapped, a colliding key simply replaces the previous entry */
+#ifndef PARAM_CACHE_SIZE
+#define PARAM_CACHE_SIZE   128
+#endif
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+
+typedef struct {
+    boolean valid;
+    unsigned int valueLen;
+    char key[MAX_KEY_LEN];
+    char value[MAX_VALUE_LEN];
+} ParamCacheEntry;
+
+typedef struct {
+    boolean enabled;
+    uint32_t generation;
+    pthread_rwlock_t lock;
+    ParamCacheEntry entries[PARAM_CACHE_SIZE];
+} ParamCache;
+
+static ParamCache g_cache = { FALSE, 0, PTHREAD_RWLOCK_INITIALIZER, {{ 0 }} };
+static pthread_once_t g_cacheOnce = PTHREAD_ONCE_INIT;
+
+static uint32_t HashKey(const char* key)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void OnParamChanged(const char* key)
+{
+    (void)pthread_rwlock_wrlock(&g_cache.lock);
+    (void)__atomic_add_fetch(&g_cache.generation, 1, __ATOMIC_RELEASE);
+    if (key == NULL) {
+        for (int i = 0; i < PARAM_CACHE_SIZE; i++) {
+            g_cache.entries[i].valid = FALSE;
+        }
+    } else {
+        ParamCacheEntry* entry = &g_cache.entries[HashKey(key) % PARAM_CACHE_SIZE];
+        if (entry->valid && (strncmp(entry->key, key, MAX_KEY_LEN) == 0)) {
+            entry->valid = FALSE;
+        }
+    }
+    (void)pthread_rwlock_unlock(&g_cache.lock);
+}
+
+/* Values are only cached while external writers can be observed through inotify */
+static void InitCache(void)
+{
+    g_cache.enabled = (ParamMonitorAddListener(OnParamChanged, PARAM_EVENT_ALL) == EC_SUCCESS);
+}
+
+static boolean IsCacheEnabled(void)
+{
+    (void)pthread_once(&g_cacheOnce, InitCache);
+    return g_cache.enabled && ParamMonitorIsRunning();
+}
+
+boolean ParamCacheGet(const char* key, char* value, unsigned int len, int* ret)
+{
+    if (!IsCacheEnabled()) {
+        return FALSE;
+    }
+    boolean hit = FALSE;
+    (void)pthread_rwlock_rdlock(&g_cache.lock);
+    const ParamCacheEntry* entry = &g_cache.entries[HashKey(key) % PARAM_CACHE_SIZE];
+    if (entry->valid && (strncmp(entry->key, key, MAX_KEY_LEN) == 0)) {
+        hit = TRUE;
+        if (entry->valueLen >= len) {
+            *ret = EC_INVALID;
+        } else {
+            (void)memcpy_s(value, len, entry->value, entry->valueLen + 1);
+            *ret = (int)entry->valueLen;
+        }
+    }
+    (void)pthread_rwlock_unlock(&g_cache.lock);
+    return hit;
+}
+
+uint32_t ParamCacheGeneration(void)
+{
+    return __atomic_load_n(&g_cache.generation, __ATOMIC_ACQUIRE);
+}
+
+void ParamCachePut(const char* key, const char* value, uint32_t generation)
+{
+    size_t valueLen = strlen(value);
+    if (!IsCacheEnabled() || (valueLen >= MAX_VALUE_LEN)) {
+        return;
+    }
+    (void)pthread_rwlock_wrlock(&g_cache.lock);
+    /* A change raced with the file read, the value may already be stale */
+    if (g_cache.generation == generation) {
+        ParamCacheEntry* entry = &g_cache.entries[HashKey(key) % PARAM_CACHE_SIZE];
+        if ((strcpy_s(entry->key, MAX_KEY_LEN, key) == 0) &&
+            (memcpy_s(entry->value, MAX_VALUE_LEN, value, valueLen + 1) == 0)) {
+            entry->valueLen = (unsigned int)valueLen;
+            entry->valid = TRUE;
+        } else {
+            entry->valid = FALSE;
+        }
+    }
+    (void)pthread_rwlock_unlock(&g_cache.lock);
+}
+
+void ParamCacheEvict(const char* key)
+{
+    if (IsCacheEnabled()) {
+        OnParamChanged(key);
+    }
+}
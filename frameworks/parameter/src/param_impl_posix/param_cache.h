@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_CACHE_H
+#define PARAM_CACHE_H
+
+#include <stdint.h>
+#include "ohos_types.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+/*
+ * Looks key up in the in-process read cache.
+ * Returns TRUE on a hit, with the GetSysParam result stored in ret.
+ */
+boolean ParamCacheGet(const char* key, char* value, unsigned int len, int* ret);
+
+/*
+ * Returns the invalidation generation, to be sampled before the backing file is read
+ * and handed back to ParamCachePut.
+ */
+uint32_t ParamCacheGeneration(void);
+
+/* Caches value unless an invalidation happened since generation was sampled. */
+void ParamCachePut(const char* key, const char* value, uint32_t generation);
+
+void ParamCacheEvict(const char* key);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_CACHE_H
@@ -13,23 +13,44 @@
  * limitations under the License.
  */
 
+#ifndef __LITEOS_M__
+#define _GNU_SOURCE /* syncfs */
+#endif
 #include <ctype.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <limits.h>
+#ifndef __LITEOS_M__
+#include <pthread.h>
+#endif
 #include <securec.h>
+#ifndef __LITEOS_M__
+#include <sys/file.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include "ohos_errno.h"
 #include "param_adaptor.h"
+#ifndef __LITEOS_M__
+#include "param_seq.h"
+#include "param_txn.h"
+#endif
+#ifdef PARAM_FEATURE_NEGATIVE_CACHE
+#include "param_bloom.h"
+#endif
+#ifdef PARAM_FEATURE_READ_CACHE
+#include "param_cache.h"
+#endif
+#ifdef PARAM_FEATURE_WATCHER
+#include "param_watcher.h"
+#endif
 
 #ifndef __LITEOS_M__
-#define DATA_PATH          "/storage/data/system/param/"
 #define SYS_UID_INDEX      1000
-#else
-#ifndef DATA_PATH
-#define DATA_PATH          ""
-#endif
+/* Upper case, so neither name can collide with a parameter key */
+#define TXN_LOG_FILE       DATA_PATH "PARAM_TXN"
+#define TXN_TEMP_NAME      "PARAM_TXN.TMP"
 #endif
 
 #define MAX_KEY_PATH       128
@@ -64,43 +85,214 @@ static boolean IsValidKey(const char* key)
     return TRUE;
 }
 
-int GetSysParam(const char* key, char* value, unsigned int len)
+static boolean IsValidPrefix(const char* prefix)
 {
-    if (!IsValidKey(key) || (value == NULL) || (len > MAX_GET_VALUE_LEN)) {
-        return EC_INVALID;
+    if ((prefix == NULL) || (strlen(prefix) >= MAX_KEY_LEN)) {
+        return FALSE;
     }
-    char* keyPath = (char *)malloc(MAX_KEY_PATH + 1);
-    if (keyPath == NULL) {
+    for (const char* ch = prefix; *ch != '\0'; ch++) {
+        if (!IsValidChar(*ch)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+#ifndef __LITEOS_M__
+static pthread_once_t g_recoverOnce = PTHREAD_ONCE_INIT;
+
+/* Written aside and renamed over the key, so a reader sees either the old or the new value */
+static int WriteParamAt(int dirFd, const char* key, const char* value)
+{
+#ifdef PARAM_FEATURE_NEGATIVE_CACHE
+    ParamBloomAdd(key);
+#endif
+    int fd = openat(dirFd, TXN_TEMP_NAME, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
         return EC_FAILURE;
     }
-    if (sprintf_s(keyPath, MAX_KEY_PATH + 1, "%s%s", DATA_PATH, key) < 0) {
-        free(keyPath);
+    size_t len = strlen(value);
+    ssize_t ret = write(fd, value, len);
+    close(fd);
+    if ((ret != (ssize_t)len) || (renameat(dirFd, TXN_TEMP_NAME, dirFd, key) != 0)) {
         return EC_FAILURE;
     }
+#ifdef PARAM_FEATURE_READ_CACHE
+    ParamCacheEvict(key);
+#endif
+    ParamSeqBump(key);
+    return EC_SUCCESS;
+}
+
+static int ApplyLoggedParam(const char* key, const char* value, void* context)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+    return WriteParamAt(*(int *)context, key, value);
+}
+
+/* One flush for the whole batch instead of an fsync per key, the log can only go once it is done */
+static void RetireBatch(int dirFd)
+{
+#ifdef __linux__
+    (void)syncfs(dirFd);
+#else
+    sync();
+#endif
+    ParamTxnLogClear(TXN_LOG_FILE);
+}
+
+/* A writer died between committing a batch and retiring its log, finish its work */
+static void RecoverBatch(void)
+{
+    if (access(TXN_LOG_FILE, F_OK) != 0) {
+        return;
+    }
+    int dirFd = open(DATA_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        return;
+    }
+    if (flock(dirFd, LOCK_EX) == 0) {
+        if (ParamTxnLogReplay(TXN_LOG_FILE, ApplyLoggedParam, &dirFd) == EC_SUCCESS) {
+            RetireBatch(dirFd);
+        } else {
+            ParamTxnLogClear(TXN_LOG_FILE);
+        }
+        (void)flock(dirFd, LOCK_UN);
+    }
+    close(dirFd);
+}
+#endif
+
+/* fstat on the opened file gives the exact size read, it can not change between the two */
+static int ReadParamFd(int fd, char* value, unsigned int len)
+{
     struct stat info = {0};
-    if (stat(keyPath, &info) != F_OK) {
-        free(keyPath);
+    if (fstat(fd, &info) != 0) {
+        close(fd);
         return EC_FAILURE;
     }
     if (info.st_size >= len) {
-        free(keyPath);
+        close(fd);
         return EC_INVALID;
     }
-    int fd = open(keyPath, O_RDONLY, S_IRUSR);
-    free(keyPath);
-    keyPath = NULL;
+    ssize_t ret = read(fd, value, (size_t)info.st_size);
+    close(fd);
+    if (ret < 0) {
+        return EC_FAILURE;
+    }
+    value[ret] = '\0';
+    return (int)ret;
+}
+
+#ifndef __LITEOS_M__
+static int g_dataDirFd = -1;
+
+/* DATA_PATH is resolved once per process, keys are then looked up relative to it */
+static int GetDataDir(void)
+{
+    int dirFd = __atomic_load_n(&g_dataDirFd, __ATOMIC_ACQUIRE);
+    if (dirFd >= 0) {
+        return dirFd;
+    }
+    dirFd = open(DATA_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        return -1;
+    }
+    int expected = -1;
+    if (!__atomic_compare_exchange_n(&g_dataDirFd, &expected, dirFd, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        close(dirFd);
+        dirFd = expected;
+    }
+    return dirFd;
+}
+
+static int ReadParamAt(int dirFd, const char* key, char* value, unsigned int len)
+{
+#ifdef PARAM_FEATURE_NEGATIVE_CACHE
+    if (!ParamBloomMayContain(key)) {
+        return EC_FAILURE;
+    }
+#endif
+#ifdef PARAM_FEATURE_READ_CACHE
+    int cached = EC_FAILURE;
+    if (ParamCacheGet(key, value, len, &cached)) {
+        return cached;
+    }
+    uint32_t generation = ParamCacheGeneration();
+#endif
+    int fd = openat(dirFd, key, O_RDONLY | O_CLOEXEC);
     if (fd < 0) {
+#ifdef PARAM_FEATURE_NEGATIVE_CACHE
+        ParamBloomReportFalsePositive();
+#endif
         return EC_FAILURE;
     }
+    int ret = ReadParamFd(fd, value, len);
+#ifdef PARAM_FEATURE_READ_CACHE
+    if (ret >= 0) {
+        ParamCachePut(key, value, generation);
+    }
+#endif
+    return ret;
+}
+#endif
 
-    int ret = read(fd, value, (size_t)info.st_size);
-    close(fd);
-    fd = -1;
-    if (ret < 0) {
+int GetSysParam(const char* key, char* value, unsigned int len)
+{
+    if (!IsValidKey(key) || (value == NULL) || (len > MAX_GET_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    int dirFd = GetDataDir();
+    return (dirFd < 0) ? EC_FAILURE : ReadParamAt(dirFd, key, value, len);
+#else
+    char keyPath[MAX_KEY_PATH + 1] = {0};
+    if (sprintf_s(keyPath, sizeof(keyPath), "%s%s", DATA_PATH, key) < 0) {
+        return EC_FAILURE;
+    }
+    int fd = open(keyPath, O_RDONLY, S_IRUSR);
+    if (fd < 0) {
         return EC_FAILURE;
     }
-    value[info.st_size] = '\0';
-    return info.st_size;
+    return ReadParamFd(fd, value, len);
+#endif
+}
+
+int GetSysParams(ParameterItem* items, unsigned int count)
+{
+#ifndef __LITEOS_M__
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    /*
+     * Shared against SetSysParams, so the batch never straddles a transaction. flock belongs to the
+     * open file, so the batch takes it on a descriptor of its own rather than on the cached one.
+     */
+    int dirFd = open(DATA_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if ((dirFd >= 0) && (flock(dirFd, LOCK_SH) != 0)) {
+        close(dirFd);
+        dirFd = -1;
+    }
+#endif
+    for (unsigned int i = 0; i < count; i++) {
+        ParameterItem* item = &items[i];
+        if (!IsValidKey(item->key) || (item->value == NULL) || (item->len > MAX_GET_VALUE_LEN)) {
+            item->ret = EC_INVALID;
+            continue;
+        }
+#ifndef __LITEOS_M__
+        item->ret = (dirFd < 0) ? EC_FAILURE : ReadParamAt(dirFd, item->key, item->value, item->len);
+#else
+        item->ret = GetSysParam(item->key, item->value, item->len);
+#endif
+    }
+#ifndef __LITEOS_M__
+    if (dirFd >= 0) {
+        close(dirFd);
+    }
+#endif
+    return EC_SUCCESS;
 }
 
 int SetSysParam(const char* key, const char* value)
@@ -108,17 +300,24 @@ int SetSysParam(const char* key, const char* value)
     if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
         return EC_INVALID;
     }
-    char* keyPath = (char *)malloc(MAX_KEY_PATH + 1);
-    if (keyPath == NULL) {
+#ifndef __LITEOS_M__
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    int dirFd = GetDataDir();
+    if (dirFd < 0) {
         return EC_FAILURE;
     }
-    if (sprintf_s(keyPath, MAX_KEY_PATH + 1, "%s%s", DATA_PATH, key) < 0) {
-        free(keyPath);
+#ifdef PARAM_FEATURE_NEGATIVE_CACHE
+    /* Before the file shows up, so a concurrent reader can not be told it is missing */
+    ParamBloomAdd(key);
+#endif
+    int fd = openat(dirFd, key, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+#else
+    char keyPath[MAX_KEY_PATH + 1] = {0};
+    if (sprintf_s(keyPath, sizeof(keyPath), "%s%s", DATA_PATH, key) < 0) {
         return EC_FAILURE;
     }
     int fd = open(keyPath, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
-    free(keyPath);
-    keyPath = NULL;
+#endif
     if (fd < 0) {
         return EC_FAILURE;
     }
@@ -126,9 +325,215 @@ int SetSysParam(const char* key, const char* value)
     int ret = write(fd, value, strlen(value));
     close(fd);
     fd = -1;
+#ifdef PARAM_FEATURE_READ_CACHE
+    ParamCacheEvict(key);
+#endif
+#ifndef __LITEOS_M__
+    if (ret >= 0) {
+        ParamSeqBump(key);
+    }
+#endif
     return (ret < 0) ? EC_FAILURE : EC_SUCCESS;
 }
 
+int SetSysParams(const char** keys, const char** values, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++) {
+        if (!IsValidKey(keys[i]) || !IsValidValue(values[i], MAX_VALUE_LEN)) {
+            return EC_INVALID;
+        }
+    }
+#ifdef __LITEOS_M__
+    for (unsigned int i = 0; i < count; i++) {
+        int ret = SetSysParam(keys[i], values[i]);
+        if (ret != EC_SUCCESS) {
+            return ret;
+        }
+    }
+    return EC_SUCCESS;
+#else
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    int dirFd = open(DATA_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        return EC_FAILURE;
+    }
+    if (flock(dirFd, LOCK_EX) != 0) {
+        close(dirFd);
+        return EC_FAILURE;
+    }
+    /* The log write is the commit point, a crash after it is finished by RecoverBatch */
+    int ret = ParamTxnLogWrite(TXN_LOG_FILE, keys, values, count);
+    if (ret == EC_SUCCESS) {
+        unsigned int applied = 0;
+        while ((applied < count) && (WriteParamAt(dirFd, keys[applied], values[applied]) == EC_SUCCESS)) {
+            applied++;
+        }
+        /* A committed batch is rolled forward, its log never outlives the call */
+        if ((applied < count) && (ParamTxnLogReplay(TXN_LOG_FILE, ApplyLoggedParam, &dirFd) != EC_SUCCESS)) {
+            ret = EC_FAILURE;
+        }
+        RetireBatch(dirFd);
+    }
+    (void)flock(dirFd, LOCK_UN);
+    close(dirFd);
+    return ret;
+#endif
+}
+
+#ifndef __LITEOS_M__
+/* Straight from the file: the read cache is only told about writes by inotify, after the wake up */
+static int ReadParamUncached(const char* key, char* value, unsigned int len)
+{
+    int dirFd = GetDataDir();
+    if (dirFd < 0) {
+        return EC_FAILURE;
+    }
+    int fd = openat(dirFd, key, O_RDONLY | O_CLOEXEC);
+    return (fd < 0) ? EC_FAILURE : ReadParamFd(fd, value, len);
+}
+#endif
+
+int WaitSysParam(const char* key, const char* value, int timeout)
+{
+    if (!IsValidKey(key) || !IsValidValue(value, MAX_VALUE_LEN)) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    return ParamSeqWait(key, value, timeout, ReadParamUncached);
+#else
+    (void)timeout;
+    return EC_FAILURE;
+#endif
+}
+
+int WatchSysParam(const char* keyPrefix, ParameterChgPtr callback, void* context)
+{
+    if (!IsValidKey(keyPrefix)) {
+        return EC_INVALID;
+    }
+#ifdef PARAM_FEATURE_WATCHER
+    if (callback == NULL) {
+        return ParamWatcherRemove(keyPrefix, context);
+    }
+    return ParamWatcherAdd(keyPrefix, callback, context, ReadParamUncached);
+#else
+    (void)callback;
+    (void)context;
+    return EC_FAILURE;
+#endif
+}
+
+/* A single pass over the directory, only the entries matching the prefix are opened */
+int ForEachSysParam(const char* prefix, ParameterVisitor visitor, void* context)
+{
+    if (!IsValidPrefix(prefix) || (visitor == NULL)) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    (void)pthread_once(&g_recoverOnce, RecoverBatch);
+    int dirFd = GetDataDir();
+    if (dirFd < 0) {
+        return EC_FAILURE;
+    }
+    /*
+     * The cached directory is opened again relative to itself, not duplicated, as a duplicate
+     * would share its read position with every other walk running at the same time.
+     */
+    int walkFd = openat(dirFd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR* dir = (walkFd >= 0) ? fdopendir(walkFd) : NULL;
+    if ((dir == NULL) && (walkFd >= 0)) {
+        close(walkFd);
+    }
+#else
+    DIR* dir = opendir((DATA_PATH[0] != '\0') ? DATA_PATH : ".");
+#endif
+    if (dir == NULL) {
+        return EC_FAILURE;
+    }
+    size_t prefixLen = strlen(prefix);
+    char value[MAX_VALUE_LEN] = {0};
+    int count = 0;
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* key = entry->d_name;
+        if ((strncmp(key, prefix, prefixLen) != 0) || !IsValidKey(key) ||
+            (strcmp(key, ".") == 0) || (strcmp(key, "..") == 0)) {
+            continue;
+        }
+#ifndef __LITEOS_M__
+        int ret = ReadParamAt(dirFd, key, value, sizeof(value));
+#else
+        int ret = GetSysParam(key, value, sizeof(value));
+#endif
+        if (ret < 0) {
+            continue;
+        }
+        count++;
+        if (visitor(key, value, context) != 0) {
+            break;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+/* Commit ids come from the sequence table every write of a file bumps */
+int FindSysParam(const char* key, unsigned int* handle)
+{
+    if (!IsValidKey(key) || (handle == NULL)) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    char value[MAX_VALUE_LEN] = {0};
+    if (GetSysParam(key, value, sizeof(value)) < 0) {
+        return EC_FAILURE;
+    }
+    return ParamSeqFind(key, handle);
+#else
+    return EC_FAILURE;
+#endif
+}
+
+int GetSysParamCommitId(unsigned int handle, unsigned int* commitId)
+{
+    if (commitId == NULL) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    return ParamSeqCommitId(handle, commitId);
+#else
+    (void)handle;
+    return EC_FAILURE;
+#endif
+}
+
+int GetSysParamName(unsigned int handle, char* key, unsigned int len)
+{
+    if (key == NULL) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    return ParamSeqName(handle, key, len);
+#else
+    (void)handle;
+    (void)len;
+    return EC_FAILURE;
+#endif
+}
+
+int GetSysParamSequence(const char* prefix, unsigned int* seq)
+{
+    if (!IsValidPrefix(prefix) || (seq == NULL)) {
+        return EC_INVALID;
+    }
+#ifndef __LITEOS_M__
+    return ParamSeqGet(prefix, seq);
+#else
+    return EC_FAILURE;
+#endif
+}
+
 boolean CheckPermission(void)
 {
 #if (!defined(_WIN32) && !defined(_WIN64) && !defined(__LITEOS_M__))
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_monitor.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+
+#define MAX_LISTENERS      4
+#define EVENT_BUF_LEN      (16 * (sizeof(struct inotify_event) + NAME_MAX + 1))
+#define MONITOR_EVENTS     (IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE)
+
+typedef struct {
+    int fd;
+    boolean running;
+    int listenerCount;
+    ParamMonitorListener listeners[MAX_LISTENERS];
+    unsigned int events[MAX_LISTENERS];
+    pthread_mutex_t lock;
+} ParamMonitor;
+
+static ParamMonitor g_monitor = { -1, FALSE, 0, { NULL }, { 0 }, PTHREAD_MUTEX_INITIALIZER };
+
+static void NotifyListeners(const char* key, unsigned int events)
+{
+    int count = __atomic_load_n(&g_monitor.listenerCount, __ATOMIC_ACQUIRE);
+    for (int i = 0; i < count; i++) {
+        if ((key == NULL) || ((g_monitor.events[i] & events) != 0)) {
+            g_monitor.listeners[i](key);
+        }
+    }
+}
+
+static unsigned int ToParamEvents(uint32_t mask)
+{
+    unsigned int events = 0;
+    if ((mask & (IN_MODIFY | IN_CREATE)) != 0) {
+        events |= PARAM_EVENT_CHANGING;
+    }
+    if ((mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+        events |= PARAM_EVENT_STORED;
+    }
+    if ((mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+        events |= PARAM_EVENT_REMOVED;
+    }
+    return events;
+}
+
+static void* MonitorThread(void* arg)
+{
+    (void)arg;
+    char buffer[EVENT_BUF_LEN] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (1) {
+        ssize_t len = read(g_monitor.fd, buffer, sizeof(buffer));
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        for (char* ptr = buffer; ptr < buffer + len;) {
+            const struct inotify_event* event = (const struct inotify_event *)ptr;
+            if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                NotifyListeners(NULL, PARAM_EVENT_ALL);
+            } else if (event->len > 0) {
+                NotifyListeners(event->name, ToParamEvents(event->mask));
+            }
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    /* Nobody can be told about changes any more, flush whatever was cached */
+    __atomic_store_n(&g_monitor.running, FALSE, __ATOMIC_RELEASE);
+    NotifyListeners(NULL, PARAM_EVENT_ALL);
+    return NULL;
+}
+
+static int StartMonitor(void)
+{
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    if (inotify_add_watch(fd, DATA_PATH, MONITOR_EVENTS) < 0) {
+        close(fd);
+        return EC_FAILURE;
+    }
+    g_monitor.fd = fd;
+    g_monitor.running = TRUE;
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, MonitorThread, NULL) != 0) {
+        close(fd);
+        g_monitor.fd = -1;
+        g_monitor.running = FALSE;
+        return EC_FAILURE;
+    }
+    (void)pthread_detach(thread);
+    return EC_SUCCESS;
+}
+
+int ParamMonitorAddListener(ParamMonitorListener listener, unsigned int events)
+{
+    if ((listener == NULL) || ((events & PARAM_EVENT_ALL) == 0)) {
+        return EC_INVALID;
+    }
+    int ret = EC_SUCCESS;
+    (void)pthread_mutex_lock(&g_monitor.lock);
+    if (g_monitor.listenerCount >= MAX_LISTENERS) {
+        ret = EC_FAILURE;
+    } else if (g_monitor.fd < 0) {
+        ret = StartMonitor();
+    }
+    if (ret == EC_SUCCESS) {
+        g_monitor.listeners[g_monitor.listenerCount] = listener;
+        g_monitor.events[g_monitor.listenerCount] = events;
+        __atomic_store_n(&g_monitor.listenerCount, g_monitor.listenerCount + 1, __ATOMIC_RELEASE);
+    }
+    (void)pthread_mutex_unlock(&g_monitor.lock);
+    return ret;
+}
+
+boolean ParamMonitorIsRunning(void)
+{
+    return __atomic_load_n(&g_monitor.running, __ATOMIC_ACQUIRE);
+}
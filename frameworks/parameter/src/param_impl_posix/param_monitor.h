@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_MONITOR_H
+#define PARAM_MONITOR_H
+
+#include "ohos_types.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+/* What happened to a parameter file, listeners choose the events they are called for */
+#define PARAM_EVENT_CHANGING   0x1 /* written to, the content may still be partial */
+#define PARAM_EVENT_STORED     0x2 /* a complete value was written or renamed into place */
+#define PARAM_EVENT_REMOVED    0x4
+#define PARAM_EVENT_ALL        (PARAM_EVENT_CHANGING | PARAM_EVENT_STORED | PARAM_EVENT_REMOVED)
+
+/*
+ * Called from the monitor thread with the name of the parameter file that changed.
+ * key is NULL when events were lost and every parameter has to be considered changed.
+ */
+typedef void (*ParamMonitorListener)(const char* key);
+
+/*
+ * Registers a listener for the given PARAM_EVENT_* on the parameter directory. All listeners share
+ * one inotify instance and one thread, which is started by the first registration.
+ * Lost events are reported to every listener whatever it subscribed to.
+ */
+int ParamMonitorAddListener(ParamMonitorListener listener, unsigned int events);
+
+/* Returns FALSE once the monitor thread is gone and changes are no longer reported. */
+boolean ParamMonitorIsRunning(void);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_MONITOR_H
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_watcher.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_monitor.h"
+
+/*
+ * Prefixes are kept in a trie of first child / next sibling nodes, so a changed key finds
+ * every matching watcher in a single walk down its characters, however many are registered.
+ * All of them share the one inotify watch of the monitor.
+ */
+typedef struct Watcher {
+    ParameterChgPtr callback;
+    void* context;
+    uint32_t id; /* tells a watcher from another one registered again at the same address */
+    struct Watcher* next;
+} Watcher;
+
+typedef struct WatchNode {
+    char ch;
+    struct WatchNode* child;
+    struct WatchNode* sibling;
+    Watcher* watchers;
+} WatchNode;
+
+typedef struct {
+    boolean started;
+    int count;
+    uint32_t nextId;
+    WatchNode root;
+    ParamWatcherReader reader;
+    pthread_t dispatcher; /* valid while dispatching */
+    boolean dispatching;
+    pthread_mutex_t lock; /* the trie */
+    pthread_mutex_t dispatchLock; /* held while callbacks run */
+} ParamWatchers;
+
+typedef struct {
+    const Watcher* watcher;
+    uint32_t id;
+} WatchMatch;
+
+static ParamWatchers g_watchers = {
+    FALSE, 0, 0, { '\0', NULL, NULL, NULL }, NULL, 0, FALSE, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER
+};
+static pthread_once_t g_watchersOnce = PTHREAD_ONCE_INIT;
+
+static WatchNode* FindChild(const WatchNode* node, char ch)
+{
+    for (WatchNode* child = node->child; child != NULL; child = child->sibling) {
+        if (child->ch == ch) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+/* Must be called with the trie locked, returns the number of matches stored */
+static int CollectMatches(const char* key, WatchMatch* matches)
+{
+    int count = 0;
+    const WatchNode* node = &g_watchers.root;
+    for (const char* ch = key; (*ch != '\0') && (node != NULL); ch++) {
+        node = FindChild(node, *ch);
+        for (const Watcher* watcher = (node != NULL) ? node->watchers : NULL; watcher != NULL;
+            watcher = watcher->next) {
+            matches[count].watcher = watcher;
+            matches[count].id = watcher->id;
+            count++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Must be called with the trie locked. A callback may cancel the watch of a sibling matched
+ * along with it, which is not called any more then: the match is only trusted while the same
+ * watcher is still found on the path of key.
+ */
+static boolean StillWatching(const char* key, const WatchMatch* match, Watcher* current)
+{
+    const WatchNode* node = &g_watchers.root;
+    for (const char* ch = key; (*ch != '\0') && (node != NULL); ch++) {
+        node = FindChild(node, *ch);
+        for (const Watcher* watcher = (node != NULL) ? node->watchers : NULL; watcher != NULL;
+            watcher = watcher->next) {
+            if ((watcher == match->watcher) && (watcher->id == match->id)) {
+                *current = *watcher;
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+static void DispatchKey(const char* key)
+{
+    WatchMatch matches[PARAM_WATCHER_MAX];
+    (void)pthread_mutex_lock(&g_watchers.lock);
+    int count = CollectMatches(key, matches);
+    (void)pthread_mutex_unlock(&g_watchers.lock);
+    if (count == 0) {
+        return;
+    }
+    char value[MAX_VALUE_LEN] = {0};
+    if (g_watchers.reader(key, value, sizeof(value)) < 0) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        Watcher current = {0};
+        (void)pthread_mutex_lock(&g_watchers.lock);
+        boolean watching = StillWatching(key, &matches[i], &current);
+        (void)pthread_mutex_unlock(&g_watchers.lock);
+        if (watching) {
+            current.callback(key, value, current.context);
+        }
+    }
+}
+
+/* Events were lost, every stored key may have changed */
+static void DispatchAll(void)
+{
+    DIR* dir = opendir(DATA_PATH);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if ((entry->d_name[0] != '.') && (strlen(entry->d_name) < MAX_KEY_LEN)) {
+            DispatchKey(entry->d_name);
+        }
+    }
+    closedir(dir);
+}
+
+static void OnParamStored(const char* key)
+{
+    if (__atomic_load_n(&g_watchers.count, __ATOMIC_ACQUIRE) == 0) {
+        return;
+    }
+    (void)pthread_mutex_lock(&g_watchers.dispatchLock);
+    g_watchers.dispatcher = pthread_self();
+    __atomic_store_n(&g_watchers.dispatching, TRUE, __ATOMIC_RELEASE);
+    if (key == NULL) {
+        DispatchAll();
+    } else {
+        DispatchKey(key);
+    }
+    __atomic_store_n(&g_watchers.dispatching, FALSE, __ATOMIC_RELEASE);
+    (void)pthread_mutex_unlock(&g_watchers.dispatchLock);
+}
+
+static void StartWatchers(void)
+{
+    g_watchers.started = (ParamMonitorAddListener(OnParamStored, PARAM_EVENT_STORED) == EC_SUCCESS);
+}
+
+/* Must be called with the trie locked */
+static WatchNode* AddNode(const char* keyPrefix)
+{
+    WatchNode* node = &g_watchers.root;
+    for (const char* ch = keyPrefix; *ch != '\0'; ch++) {
+        WatchNode* child = FindChild(node, *ch);
+        if (child == NULL) {
+            child = (WatchNode *)calloc(1, sizeof(WatchNode));
+            if (child == NULL) {
+                return NULL;
+            }
+            child->ch = *ch;
+            child->sibling = node->child;
+            node->child = child;
+        }
+        node = child;
+    }
+    return node;
+}
+
+/* Must be called with the trie locked, frees the nodes left without watcher nor child on the way back */
+static int RemoveWatcher(WatchNode** link, const char* keyPrefix, const void* context)
+{
+    WatchNode* node = *link;
+    int ret = EC_FAILURE;
+    if (*keyPrefix != '\0') {
+        WatchNode** childLink = &node->child;
+        while ((*childLink != NULL) && ((*childLink)->ch != *keyPrefix)) {
+            childLink = &(*childLink)->sibling;
+        }
+        ret = (*childLink != NULL) ? RemoveWatcher(childLink, keyPrefix + 1, context) : EC_FAILURE;
+    } else {
+        for (Watcher** watcher = &node->watchers; *watcher != NULL; watcher = &(*watcher)->next) {
+            if ((*watcher)->context == context) {
+                Watcher* removed = *watcher;
+                *watcher = removed->next;
+                free(removed);
+                ret = EC_SUCCESS;
+                break;
+            }
+        }
+    }
+    if ((node != &g_watchers.root) && (node->watchers == NULL) && (node->child == NULL)) {
+        *link = node->sibling;
+        free(node);
+    }
+    return ret;
+}
+
+int ParamWatcherAdd(const char* keyPrefix, ParameterChgPtr callback, void* context, ParamWatcherReader reader)
+{
+    if ((keyPrefix == NULL) || (*keyPrefix == '\0') || (callback == NULL) || (reader == NULL)) {
+        return EC_INVALID;
+    }
+    (void)pthread_once(&g_watchersOnce, StartWatchers);
+    if (!g_watchers.started || !ParamMonitorIsRunning()) {
+        return EC_FAILURE;
+    }
+    int ret = EC_SUCCESS;
+    (void)pthread_mutex_lock(&g_watchers.lock);
+    g_watchers.reader = reader;
+    WatchNode* node = AddNode(keyPrefix);
+    Watcher* watcher = (node != NULL) ? node->watchers : NULL;
+    while ((watcher != NULL) && (watcher->context != context)) {
+        watcher = watcher->next;
+    }
+    if (node == NULL) {
+        ret = EC_NOMEMORY;
+    } else if (watcher != NULL) {
+        watcher->callback = callback;
+    } else if (g_watchers.count >= PARAM_WATCHER_MAX) {
+        ret = EC_FAILURE;
+    } else if ((watcher = (Watcher *)malloc(sizeof(Watcher))) == NULL) {
+        ret = EC_NOMEMORY;
+    } else {
+        watcher->callback = callback;
+        watcher->context = context;
+        watcher->id = g_watchers.nextId++;
+        watcher->next = node->watchers;
+        node->watchers = watcher;
+        __atomic_store_n(&g_watchers.count, g_watchers.count + 1, __ATOMIC_RELEASE);
+    }
+    if ((node != NULL) && (node->watchers == NULL)) {
+        WatchNode* root = &g_watchers.root;
+        (void)RemoveWatcher(&root, keyPrefix, context); /* drops the nodes added for nothing */
+    }
+    (void)pthread_mutex_unlock(&g_watchers.lock);
+    return ret;
+}
+
+int ParamWatcherRemove(const char* keyPrefix, void* context)
+{
+    if ((keyPrefix == NULL) || (*keyPrefix == '\0')) {
+        return EC_INVALID;
+    }
+    /* A callback may cancel its own watch, the dispatch it runs in is not waited for then */
+    boolean fromCallback = __atomic_load_n(&g_watchers.dispatching, __ATOMIC_ACQUIRE) &&
+        pthread_equal(g_watchers.dispatcher, pthread_self());
+    if (!fromCallback) {
+        (void)pthread_mutex_lock(&g_watchers.dispatchLock);
+    }
+    (void)pthread_mutex_lock(&g_watchers.lock);
+    WatchNode* root = &g_watchers.root;
+    int ret = RemoveWatcher(&root, keyPrefix, context);
+    if (ret == EC_SUCCESS) {
+        __atomic_store_n(&g_watchers.count, g_watchers.count - 1, __ATOMIC_RELEASE);
+    }
+    (void)pthread_mutex_unlock(&g_watchers.lock);
+    if (!fromCallback) {
+        (void)pthread_mutex_unlock(&g_watchers.dispatchLock);
+    }
+    return ret;
+}
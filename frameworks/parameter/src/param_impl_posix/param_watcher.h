@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_WATCHER_H
+#define PARAM_WATCHER_H
+
+#include "ohos_types.h"
+#include "parameter.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+#ifndef PARAM_WATCHER_MAX
+#define PARAM_WATCHER_MAX  32
+#endif
+
+/* Reads the value handed to the callbacks, it must not lag behind the file that changed */
+typedef int (*ParamWatcherReader)(const char* key, char* value, unsigned int len);
+
+/*
+ * Calls callback from the monitor thread whenever a key starting with keyPrefix is stored,
+ * by this process or any other. Registering the same keyPrefix and context again replaces
+ * the callback.
+ */
+int ParamWatcherAdd(const char* keyPrefix, ParameterChgPtr callback, void* context, ParamWatcherReader reader);
+
+/*
+ * Removes the watch of keyPrefix registered with context.
+ * Once it returns, the callback is not running and will not be called again for it.
+ */
+int ParamWatcherRemove(const char* keyPrefix, void* context);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_WATCHER_H
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_seq.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <securec.h>
+#include <stdint.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef SYS_futex
+#include <linux/futex.h>
+#endif
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+
+/*
+ * One shared page of sequence numbers, every process maps it. A write bumps the bucket of its key,
+ * and waiters sleep on that bucket with a futex, so they wake up as soon as the value changes
+ * instead of polling it. Keys sharing a bucket only cost a spurious wake up.
+ * The write also bumps the global sequence and the bucket of every prefix of its key ending with
+ * a dot, so a cache of "persist.sys." revalidates with one load, whatever the number of its keys.
+ */
+#define SEQ_FILE           DATA_PATH "PARAM_SEQ"
+#define SEQ_MAGIC          0x50534551
+#define SEQ_VERSION        2
+#define SEQ_BUCKETS        256
+#define SEQ_PREFIX_BUCKETS 256
+#define SEQ_POLL_INTERVAL  10 /* ms, only where there is no futex */
+#define SEQ_UNSEEN_POLL    100 /* ms, waiters that can not announce themselves on a read-only page */
+#define SEQ_LOCK_RETRY     10 /* 1 ms apart */
+#define MS_PER_SECOND      1000
+#define NS_PER_MS          1000000
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+#define SEQ_HANDLE_MAX     128
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t waiters; /* writers skip the wake up system call while nobody waits */
+    uint32_t global;
+    uint32_t buckets[SEQ_BUCKETS];
+    uint32_t prefixes[SEQ_PREFIX_BUCKETS];
+} SeqTable;
+
+typedef struct {
+    char key[MAX_KEY_LEN];
+    uint32_t* bucket;
+} SeqHandle;
+
+static SeqTable* g_seqTable = NULL;
+static boolean g_seqWritable = FALSE;
+
+/* Only ever appended to, an entry is complete before the count covers it */
+static SeqHandle g_seqHandles[SEQ_HANDLE_MAX];
+static unsigned int g_seqHandleCount = 0;
+static pthread_mutex_t g_seqHandleLock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t HashKey(const char* key)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/*
+ * Lays out a table the first process to come finds missing or older. Every layout only appended
+ * to the one before, and any counter is a valid start, so the file is only ever grown and stamped:
+ * processes still mapping an older layout keep on working on a file that never shrinks under them.
+ */
+static int InitSeqFile(int fd)
+{
+    struct stat info = {0};
+    uint32_t header[2] = { 0 }; /* 2: magic and version */
+    if ((flock(fd, LOCK_EX) != 0) || (fstat(fd, &info) != 0)) {
+        return EC_FAILURE;
+    }
+    int ret = EC_SUCCESS;
+    if (((size_t)info.st_size < sizeof(SeqTable)) && (ftruncate(fd, sizeof(SeqTable)) != 0)) {
+        ret = EC_FAILURE;
+    } else if ((pread(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)) ||
+        (header[0] != SEQ_MAGIC) || (header[1] != SEQ_VERSION)) {
+        header[0] = SEQ_MAGIC;
+        header[1] = SEQ_VERSION;
+        if (pwrite(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+            ret = EC_FAILURE;
+        }
+    }
+    (void)flock(fd, LOCK_UN);
+    return ret;
+}
+
+/* A table another layout than this one or not laid out yet is not trusted */
+static boolean IsSeqFileReady(int fd)
+{
+    struct stat info = {0};
+    uint32_t header[2] = { 0 }; /* 2: magic and version */
+    return (fstat(fd, &info) == 0) && ((size_t)info.st_size >= sizeof(SeqTable)) &&
+        (pread(fd, header, sizeof(header), 0) == (ssize_t)sizeof(header)) &&
+        (header[0] == SEQ_MAGIC) && (header[1] == SEQ_VERSION);
+}
+
+/*
+ * A reader only looks at the table between two writers laying it out, and never keeps them
+ * waiting: it does not block on the lock, and drops it before mapping, as a mapping would keep
+ * the lock of the open file held for as long as it lives.
+ */
+static boolean IsSeqFileReadyForReader(int fd)
+{
+    for (int retry = 0; retry < SEQ_LOCK_RETRY; retry++) {
+        if (flock(fd, LOCK_SH | LOCK_NB) == 0) {
+            boolean ready = IsSeqFileReady(fd);
+            (void)flock(fd, LOCK_UN);
+            return ready;
+        }
+        if (errno != EWOULDBLOCK) {
+            return FALSE;
+        }
+        struct timespec interval = { 0, NS_PER_MS };
+        (void)nanosleep(&interval, NULL);
+    }
+    return FALSE;
+}
+
+/* Processes that may not store parameters map the table read-only, it is only ever read there */
+static SeqTable* MapSeqTable(boolean* writable)
+{
+    *writable = TRUE;
+    int fd = open(SEQ_FILE, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if ((fd < 0) && (errno == EACCES)) {
+        *writable = FALSE;
+        fd = open(SEQ_FILE, O_RDONLY | O_CLOEXEC);
+    }
+    if (fd < 0) {
+        return NULL;
+    }
+    /* A reader can not lay the table out itself, it tries again on its next call */
+    if (*writable ? ((InitSeqFile(fd) != EC_SUCCESS) || !IsSeqFileReady(fd)) : !IsSeqFileReadyForReader(fd)) {
+        close(fd);
+        return NULL;
+    }
+    int prot = *writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* addr = mmap(NULL, sizeof(SeqTable), prot, MAP_SHARED, fd, 0);
+    close(fd);
+    return (addr != MAP_FAILED) ? (SeqTable *)addr : NULL;
+}
+
+/*
+ * Mapped again on every call until it works: a process started before any writer laid the table
+ * out, the very one waiting for the boot to go on, gets it as soon as it exists.
+ */
+static SeqTable* GetSeqTable(void)
+{
+    SeqTable* table = __atomic_load_n(&g_seqTable, __ATOMIC_ACQUIRE);
+    if (table != NULL) {
+        return table;
+    }
+    boolean writable = FALSE;
+    table = MapSeqTable(&writable);
+    if (table == NULL) {
+        return NULL;
+    }
+    /* Every thread of the process finds the same access, whichever of them wins the race */
+    __atomic_store_n(&g_seqWritable, writable, __ATOMIC_RELAXED);
+    SeqTable* expected = NULL;
+    if (!__atomic_compare_exchange_n(&g_seqTable, &expected, table, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        munmap(table, sizeof(SeqTable));
+        table = expected;
+    }
+    return table;
+}
+
+/* The hash of every prefix ending with a dot is a step of the hash of the key */
+static void BumpPrefixes(SeqTable* table, const char* key)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (const char* ch = key; *ch != '\0'; ch++) {
+        hash ^= (unsigned char)*ch;
+        hash *= FNV_PRIME;
+        if (*ch == '.') {
+            (void)__atomic_add_fetch(&table->prefixes[hash % SEQ_PREFIX_BUCKETS], 1, __ATOMIC_SEQ_CST);
+        }
+    }
+}
+
+void ParamSeqBump(const char* key)
+{
+    SeqTable* table = GetSeqTable();
+    if ((table == NULL) || !__atomic_load_n(&g_seqWritable, __ATOMIC_RELAXED)) {
+        return;
+    }
+    BumpPrefixes(table, key);
+    (void)__atomic_add_fetch(&table->global, 1, __ATOMIC_SEQ_CST);
+    uint32_t* bucket = &table->buckets[HashKey(key) % SEQ_BUCKETS];
+    (void)__atomic_add_fetch(bucket, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&table->waiters, __ATOMIC_SEQ_CST) == 0) {
+        return;
+    }
+#ifdef SYS_futex
+    (void)syscall(SYS_futex, bucket, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static boolean IsExpected(const char* key, const char* value, ParamSeqReader reader)
+{
+    char current[MAX_VALUE_LEN] = {0};
+    if (reader(key, current, sizeof(current)) <= 0) {
+        return FALSE;
+    }
+    return (strcmp(value, "*") == 0) || (strcmp(value, current) == 0);
+}
+
+static int64_t NowMs(void)
+{
+    struct timespec now = {0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * MS_PER_SECOND + now.tv_nsec / NS_PER_MS;
+}
+
+/* Sleeps until the bucket moves on from seq or waitMs passed, waitMs < 0 meaning for ever */
+static void SleepOnBucket(uint32_t* bucket, uint32_t seq, int64_t waitMs)
+{
+#ifdef SYS_futex
+    struct timespec timeout = { (time_t)(waitMs / MS_PER_SECOND), (long)(waitMs % MS_PER_SECOND) * NS_PER_MS };
+    (void)syscall(SYS_futex, bucket, FUTEX_WAIT, seq, (waitMs < 0) ? NULL : &timeout, NULL, 0);
+#else
+    (void)bucket;
+    (void)seq;
+    int64_t sleepMs = ((waitMs < 0) || (waitMs > SEQ_POLL_INTERVAL)) ? SEQ_POLL_INTERVAL : waitMs;
+    struct timespec interval = { 0, (long)sleepMs * NS_PER_MS };
+    (void)nanosleep(&interval, NULL);
+#endif
+}
+
+int ParamSeqWait(const char* key, const char* value, int timeout, ParamSeqReader reader)
+{
+    SeqTable* table = GetSeqTable();
+    if (table == NULL) {
+        return EC_FAILURE;
+    }
+    uint32_t* bucket = &table->buckets[HashKey(key) % SEQ_BUCKETS];
+    int64_t deadline = (timeout > 0) ? NowMs() + (int64_t)timeout * MS_PER_SECOND : -1;
+    int ret = EC_TIMEOUT;
+    /* Writers only wake the waiters they know of, one that can not tell them looks again now and then */
+    boolean announced = __atomic_load_n(&g_seqWritable, __ATOMIC_RELAXED);
+    if (announced) {
+        (void)__atomic_add_fetch(&table->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    while (1) {
+        /* Sampled before the value is read, so a write in between makes the sleep return at once */
+        uint32_t seq = __atomic_load_n(bucket, __ATOMIC_SEQ_CST);
+        if (IsExpected(key, value, reader)) {
+            ret = EC_SUCCESS;
+            break;
+        }
+        int64_t waitMs = -1;
+        if (deadline >= 0) {
+            waitMs = deadline - NowMs();
+            if (waitMs <= 0) {
+                break;
+            }
+        }
+        if (!announced && ((waitMs < 0) || (waitMs > SEQ_UNSEEN_POLL))) {
+            waitMs = SEQ_UNSEEN_POLL;
+        }
+        SleepOnBucket(bucket, seq, waitMs);
+    }
+    if (announced) {
+        (void)__atomic_sub_fetch(&table->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    return ret;
+}
+
+int ParamSeqFind(const char* key, unsigned int* handle)
+{
+    SeqTable* table = GetSeqTable();
+    if (table == NULL) {
+        return EC_FAILURE;
+    }
+    int ret = EC_FAILURE;
+    (void)pthread_mutex_lock(&g_seqHandleLock);
+    unsigned int index = 0;
+    while ((index < g_seqHandleCount) && (strcmp(g_seqHandles[index].key, key) != 0)) {
+        index++;
+    }
+    if (index < g_seqHandleCount) {
+        *handle = index;
+        ret = EC_SUCCESS;
+    } else if ((index < SEQ_HANDLE_MAX) && (strcpy_s(g_seqHandles[index].key, MAX_KEY_LEN, key) == 0)) {
+        g_seqHandles[index].bucket = &table->buckets[HashKey(key) % SEQ_BUCKETS];
+        __atomic_store_n(&g_seqHandleCount, index + 1, __ATOMIC_RELEASE);
+        *handle = index;
+        ret = EC_SUCCESS;
+    }
+    (void)pthread_mutex_unlock(&g_seqHandleLock);
+    return ret;
+}
+
+static const SeqHandle* GetSeqHandle(unsigned int handle)
+{
+    return (handle < __atomic_load_n(&g_seqHandleCount, __ATOMIC_ACQUIRE)) ? &g_seqHandles[handle] : NULL;
+}
+
+/* No lock nor system call, a single load of the shared page */
+int ParamSeqCommitId(unsigned int handle, unsigned int* commitId)
+{
+    const SeqHandle* entry = GetSeqHandle(handle);
+    if (entry == NULL) {
+        return EC_INVALID;
+    }
+    *commitId = __atomic_load_n(entry->bucket, __ATOMIC_ACQUIRE);
+    return EC_SUCCESS;
+}
+
+int ParamSeqName(unsigned int handle, char* key, unsigned int len)
+{
+    const SeqHandle* entry = GetSeqHandle(handle);
+    if (entry == NULL) {
+        return EC_INVALID;
+    }
+    return (strcpy_s(key, len, entry->key) == 0) ? EC_SUCCESS : EC_INVALID;
+}
+
+int ParamSeqGet(const char* prefix, uint32_t* seq)
+{
+    SeqTable* table = GetSeqTable();
+    if (table == NULL) {
+        return EC_FAILURE;
+    }
+    size_t prefixLen = strlen(prefix);
+    const uint32_t* counter = &table->global;
+    if ((prefixLen > 0) && (prefix[prefixLen - 1] == '.')) {
+        counter = &table->prefixes[HashKey(prefix) % SEQ_PREFIX_BUCKETS];
+    } else if (prefixLen > 0) {
+        counter = &table->buckets[HashKey(prefix) % SEQ_BUCKETS];
+    }
+    *seq = __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+    return EC_SUCCESS;
+}
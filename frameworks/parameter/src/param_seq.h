@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_SEQ_H
+#define PARAM_SEQ_H
+
+#include <stdint.h>
+#include "ohos_types.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+/* Reads the current value of key, bypassing any cache that may lag behind other processes */
+typedef int (*ParamSeqReader)(const char* key, char* value, unsigned int len);
+
+/* To be called by the backends once the new value of key is visible, wakes up the waiters on it */
+void ParamSeqBump(const char* key);
+
+/*
+ * Blocks until key holds value, or any value when value is "*".
+ * timeout is in seconds, 0 or less waits for ever.
+ * Returns EC_SUCCESS, EC_TIMEOUT, or EC_FAILURE when the sequence table is not available.
+ */
+int ParamSeqWait(const char* key, const char* value, int timeout, ParamSeqReader reader);
+
+/*
+ * Handles name keys for the life of the process. The commit id of a handle is the sequence number
+ * of the bucket of its key: every store of the key moves it on, a store of another key of the same
+ * bucket may too. Sampled before the value is read, an unchanged commit id means an unchanged value.
+ */
+int ParamSeqFind(const char* key, unsigned int* handle);
+int ParamSeqCommitId(unsigned int handle, unsigned int* commitId);
+int ParamSeqName(unsigned int handle, char* key, unsigned int len);
+
+/*
+ * The sequence number of the keys starting with prefix when it ends with a dot, of the key prefix
+ * otherwise, and of every key when it is empty. Any store under it moves it on, and possibly a
+ * store of a key outside of it sharing its bucket.
+ */
+int ParamSeqGet(const char* prefix, uint32_t* seq);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_SEQ_H
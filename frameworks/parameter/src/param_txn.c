@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "param_txn.h"
+
+#include <fcntl.h>
+#include <securec.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+
+/*
+ * The log is a header followed by "key\0value\0" pairs. A crash while it is written leaves
+ * a checksum mismatch, which is what tells a torn, uncommitted batch from a committed one.
+ */
+#define TXN_LOG_MAGIC      0x5054584E
+#define TXN_LOG_MAX_SIZE   (64 * 1024)
+#define FNV_OFFSET_BASIS   2166136261U
+#define FNV_PRIME          16777619U
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    uint32_t size;
+    uint32_t checksum;
+} TxnLogHeader;
+
+static uint32_t Checksum(const char* data, uint32_t size, uint32_t count)
+{
+    uint32_t hash = FNV_OFFSET_BASIS ^ count;
+    for (uint32_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static int WriteAll(int fd, const char* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t ret = write(fd, data, size);
+        if (ret <= 0) {
+            return EC_FAILURE;
+        }
+        data += ret;
+        size -= (size_t)ret;
+    }
+    return EC_SUCCESS;
+}
+
+static int AppendString(char* buffer, uint32_t size, uint32_t* offset, const char* str)
+{
+    size_t len = strlen(str) + 1;
+    if ((len > size - *offset) || (memcpy_s(buffer + *offset, size - *offset, str, len) != 0)) {
+        return EC_FAILURE;
+    }
+    *offset += (uint32_t)len;
+    return EC_SUCCESS;
+}
+
+int ParamTxnLogWrite(const char* path, const char** keys, const char** values, unsigned int count)
+{
+    if ((count == 0) || (count > TXN_LOG_MAX_SIZE / (MAX_KEY_LEN + MAX_VALUE_LEN))) {
+        return EC_INVALID;
+    }
+    uint32_t capacity = sizeof(TxnLogHeader) + count * (MAX_KEY_LEN + MAX_VALUE_LEN);
+    char* buffer = (char *)malloc(capacity);
+    if (buffer == NULL) {
+        return EC_NOMEMORY;
+    }
+    uint32_t offset = sizeof(TxnLogHeader);
+    for (unsigned int i = 0; i < count; i++) {
+        if ((AppendString(buffer, capacity, &offset, keys[i]) != EC_SUCCESS) ||
+            (AppendString(buffer, capacity, &offset, values[i]) != EC_SUCCESS)) {
+            free(buffer);
+            return EC_INVALID;
+        }
+    }
+    TxnLogHeader* header = (TxnLogHeader *)buffer;
+    header->magic = TXN_LOG_MAGIC;
+    header->count = count;
+    header->size = offset - sizeof(TxnLogHeader);
+    header->checksum = Checksum(buffer + sizeof(TxnLogHeader), header->size, count);
+
+    int ret = EC_FAILURE;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd >= 0) {
+        if ((WriteAll(fd, buffer, offset) == EC_SUCCESS) && (fsync(fd) == 0)) {
+            ret = EC_SUCCESS;
+        }
+        close(fd);
+    }
+    free(buffer);
+    return ret;
+}
+
+static char* ReadLog(const char* path, TxnLogHeader* header)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    char* payload = NULL;
+    if ((read(fd, header, sizeof(TxnLogHeader)) == (ssize_t)sizeof(TxnLogHeader)) &&
+        (header->magic == TXN_LOG_MAGIC) && (header->size > 0) && (header->size <= TXN_LOG_MAX_SIZE)) {
+        payload = (char *)malloc(header->size);
+    }
+    if ((payload != NULL) && ((read(fd, payload, header->size) != (ssize_t)header->size) ||
+        (payload[header->size - 1] != '\0') ||
+        (Checksum(payload, header->size, header->count) != header->checksum))) {
+        free(payload);
+        payload = NULL;
+    }
+    close(fd);
+    return payload;
+}
+
+int ParamTxnLogReplay(const char* path, ParamTxnApply apply, void* context)
+{
+    TxnLogHeader header = {0};
+    char* payload = ReadLog(path, &header);
+    if (payload == NULL) {
+        return EC_FAILURE;
+    }
+    int ret = EC_SUCCESS;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; (i < header.count) && (offset < header.size); i++) {
+        const char* key = payload + offset;
+        offset += (uint32_t)strlen(key) + 1;
+        if (offset >= header.size) {
+            break;
+        }
+        const char* value = payload + offset;
+        offset += (uint32_t)strlen(value) + 1;
+        if (apply(key, value, context) != EC_SUCCESS) {
+            ret = EC_FAILURE;
+        }
+    }
+    free(payload);
+    return ret;
+}
+
+void ParamTxnLogClear(const char* path)
+{
+    (void)unlink(path);
+}
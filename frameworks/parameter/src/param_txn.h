@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAM_TXN_H
+#define PARAM_TXN_H
+
+#include "ohos_types.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif /* __cplusplus */
+
+/* Applies one logged parameter to the storage, returns EC_SUCCESS or an error code */
+typedef int (*ParamTxnApply)(const char* key, const char* value, void* context);
+
+/*
+ * Writes a batch to the transaction log at path with a single write and a single fsync.
+ * Once this returns EC_SUCCESS the batch is committed: if the process dies before the storage
+ * is updated, ParamTxnLogReplay applies it again. Callers serialize writers themselves.
+ */
+int ParamTxnLogWrite(const char* path, const char** keys, const char** values, unsigned int count);
+
+/*
+ * Hands every entry of an intact log to apply.
+ * Returns EC_FAILURE when there is no log, or when it was torn and the batch never committed.
+ */
+int ParamTxnLogReplay(const char* path, ParamTxnApply apply, void* context);
+
+/* Retires the log, to be called once the applied batch is durable in the storage itself */
+void ParamTxnLogClear(const char* path);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+#endif  // PARAM_TXN_H
@@ -14,6 +14,9 @@
  */
 
 #include <fcntl.h>
+#ifndef __LITEOS_M__
+#include <pthread.h>
+#endif
 #include <securec.h>
 #include <stdio.h>
 #include <sys/types.h>
@@ -22,32 +25,45 @@
 #ifdef USE_MBEDTLS
 #include "mbedtls/sha256.h"
 #endif
+#include "ohos_build_info.h"
 #include "ohos_errno.h"
 #include "param_adaptor.h"
 #include "parameter.h"
 
 #define FILE_RO "ro."
-#define OS_FULL_NAME_LEN 128
 #define VERSION_ID_LEN 256
 #define HASH_LENGTH 32
-#define DEV_BUF_LENGTH 3
+#define HEX_HIGH_SHIFT 4
+#define HEX_LOW_MASK 0x0F
 #define DEV_BUF_MAX_LENGTH 1024
 #define DEV_UUID_LENGTH 65
 #define OHOS_DISPLAY_VERSION_LEN 128
 #define OHOS_PATCH_VERSION_LEN 64
 #define OHOS_PATCH_VERSION_FILE "/patch/pversion"
 
-static const char OHOS_OS_NAME[] = { "OpenHarmony" };
-static const int OHOS_SDK_API_VERSION = 6;
-static const char OHOS_SECURITY_PATCH_TAG[] = {"2021-09-01"};
-static const char OHOS_RELEASE_TYPE[] = { "Beta" };
+static const char EMPTY_STR[] = { "" };
 
-static const int MAJOR_VERSION = 1;
-static const int SENIOR_VERSION = 0;
-static const int FEATURE_VERSION = 1;
-static const int BUILD_VERSION = 0;
+/* Properties composed from HAL values, once: they are known at runtime only */
+typedef int (*ComposeFunc)(char *value, unsigned int len);
 
-static const char EMPTY_STR[] = { "" };
+#define COMPOSED_MAX_LEN VERSION_ID_LEN /* the longest of them */
+#define COMPOSE_FREE 0
+#define COMPOSE_COPYING 1
+#define COMPOSE_READY 2
+
+#ifndef __LITEOS_M__
+static pthread_mutex_t g_composeLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static char g_versionId[VERSION_ID_LEN] = {0};
+static int g_versionIdReady = COMPOSE_FREE;
+static char g_displayVersion[OHOS_DISPLAY_VERSION_LEN] = {0};
+static int g_displayVersionReady = COMPOSE_FREE;
+#ifdef USE_MBEDTLS
+/* Only depends on const parameters and the serial, hashed once per process */
+static char g_devUdid[DEV_UUID_LENGTH] = {0};
+static int g_devUdidReady = COMPOSE_FREE;
+#endif
 
 static boolean IsValidValue(const char *value, unsigned int len)
 {
@@ -57,6 +73,20 @@ static boolean IsValidValue(const char *value, unsigned int len)
     return TRUE;
 }
 
+static int ApplyDefault(int ret, const char *def, char *value, unsigned int len)
+{
+    if (ret == EC_INVALID) {
+        return EC_INVALID;
+    }
+    if ((ret < 0) && IsValidValue(def, len)) {
+        if (strncpy_s(value, len, def, len - 1) != 0) {
+            return EC_FAILURE;
+        }
+        ret = (int)strlen(def);
+    }
+    return ret;
+}
+
 int GetParameter(const char *key, const char *def, char *value, unsigned int len)
 {
     if ((key == NULL) || (value == NULL)) {
@@ -66,16 +96,27 @@ int GetParameter(const char *key, const char *def, char *value, unsigned int len
         return EC_FAILURE;
     }
     int ret = GetSysParam(key, value, len);
-    if (ret == EC_INVALID) {
+    return ApplyDefault(ret, def, value, len);
+}
+
+int GetParameters(ParameterItem *items, unsigned int count)
+{
+    if ((items == NULL) || (count == 0)) {
         return EC_INVALID;
     }
-    if ((ret < 0) && IsValidValue(def, len)) {
-        if (strncpy_s(value, len, def, len - 1) != 0) {
-            return EC_FAILURE;
-        }
-        ret = (int)strlen(def);
+    if (!CheckPermission()) {
+        return EC_FAILURE;
     }
-    return ret;
+    int ret = GetSysParams(items, count);
+    if (ret != EC_SUCCESS) {
+        return ret;
+    }
+    int found = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        items[i].ret = ApplyDefault(items[i].ret, items[i].def, items[i].value, items[i].len);
+        found += (items[i].ret >= 0) ? 1 : 0;
+    }
+    return found;
 }
 
 int SetParameter(const char *key, const char *value)
@@ -93,6 +134,110 @@ int SetParameter(const char *key, const char *value)
     return SetSysParam(key, value);
 }
 
+int SetParameters(const char *keys[], const char *values[], unsigned int count)
+{
+    if ((keys == NULL) || (values == NULL) || (count == 0)) {
+        return EC_INVALID;
+    }
+    if (!CheckPermission()) {
+        return EC_FAILURE;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        if ((keys[i] == NULL) || (values[i] == NULL) || (strncmp(keys[i], FILE_RO, strlen(FILE_RO)) == 0)) {
+            return EC_INVALID;
+        }
+    }
+    return SetSysParams(keys, values, count);
+}
+
+int WaitParameter(const char *key, const char *value, int timeout)
+{
+    if ((key == NULL) || (value == NULL)) {
+        return EC_INVALID;
+    }
+    if (!CheckPermission()) {
+        return EC_FAILURE;
+    }
+    return WaitSysParam(key, value, timeout);
+}
+
+int WatchParameter(const char *keyprefix, ParameterChgPtr callback, void *context)
+{
+    if (keyprefix == NULL) {
+        return EC_INVALID;
+    }
+    if (!CheckPermission()) {
+        return EC_FAILURE;
+    }
+    return WatchSysParam(keyprefix, callback, context);
+}
+
+int ForEachParameter(const char *prefix, ParameterVisitor visitor, void *context)
+{
+    if ((prefix == NULL) || (visitor == NULL)) {
+        return EC_INVALID;
+    }
+    if (!CheckPermission()) {
+        return EC_FAILURE;
+    }
+    return ForEachSysParam(prefix, visitor, context);
+}
+
+unsigned int FindParameter(const char *key)
+{
+    unsigned int handle = 0;
+    if ((key == NULL) || !CheckPermission() || (FindSysParam(key, &handle) != EC_SUCCESS)) {
+        return (unsigned int)-1;
+    }
+    return handle;
+}
+
+/* The hot path of change detection, the permission was checked when the handle was found */
+unsigned int GetParameterCommitId(unsigned int handle)
+{
+    unsigned int commitId = 0;
+    if (GetSysParamCommitId(handle, &commitId) != EC_SUCCESS) {
+        return (unsigned int)-1;
+    }
+    return commitId;
+}
+
+int GetParameterName(unsigned int handle, char *key, unsigned int len)
+{
+    if (key == NULL) {
+        return EC_INVALID;
+    }
+    int ret = GetSysParamName(handle, key, len);
+    return (ret != EC_SUCCESS) ? ret : (int)strlen(key);
+}
+
+int GetParameterValue(unsigned int handle, char *value, unsigned int len)
+{
+    if (value == NULL) {
+        return EC_INVALID;
+    }
+    if (!CheckPermission()) {
+        return EC_FAILURE;
+    }
+    char key[MAX_KEY_LEN] = {0};
+    int ret = GetSysParamName(handle, key, sizeof(key));
+    if (ret != EC_SUCCESS) {
+        return ret;
+    }
+    return GetSysParam(key, value, len);
+}
+
+/* Meant to be polled by caches, so like the commit id it is not behind the permission check */
+long long GetParameterSequence(const char *prefix)
+{
+    if (prefix == NULL) {
+        return EC_INVALID;
+    }
+    unsigned int seq = 0;
+    int ret = GetSysParamSequence(prefix, &seq);
+    return (ret != EC_SUCCESS) ? ret : (long long)seq;
+}
+
 const char *GetDeviceType(void)
 {
     return HalGetDeviceType();
@@ -158,52 +303,54 @@ const char *GetAbiList(void)
     return HalGetAbiList();
 }
 
-static const char *BuildOSFullName(void)
+const char *GetOSFullName(void)
 {
-    const char release[] = "Release";
-    char value[OS_FULL_NAME_LEN];
-    const char *releaseType = GetOsReleaseType();
-    int length;
-    if (strncmp(releaseType, release, sizeof(release) - 1) == 0) {
-        length = sprintf_s(value, OS_FULL_NAME_LEN, "%s-%d.%d.%d.%d",
-            OHOS_OS_NAME, MAJOR_VERSION, SENIOR_VERSION, FEATURE_VERSION, BUILD_VERSION);
-    } else {
-        length = sprintf_s(value, OS_FULL_NAME_LEN, "%s-%d.%d.%d.%d(%s)",
-            OHOS_OS_NAME, MAJOR_VERSION, SENIOR_VERSION, FEATURE_VERSION, BUILD_VERSION, releaseType);
-    }
-    if (length < 0) {
-        return EMPTY_STR;
-    }
-    const char *osFullName = strdup(value);
-    return osFullName;
+    return OHOS_OS_FULL_NAME;
 }
 
-const char *GetOSFullName(void)
+/*
+ * Concurrent first calls each compose the value on their own stack, and it is copied into the
+ * shared buffer exactly once, before the flag is set: a caller never sees a partial value, nor
+ * one being copied over. Without threads of the POSIX kind, a call racing the copy of another
+ * one gets NULL, as if the value could not be composed.
+ */
+static const char *GetComposed(char *value, unsigned int len, int *state, ComposeFunc compose)
 {
-    static const char *osFullName = NULL;
-    if (osFullName != NULL) {
-        return osFullName;
+    if (__atomic_load_n(state, __ATOMIC_ACQUIRE) == COMPOSE_READY) {
+        return value;
     }
-    osFullName = BuildOSFullName();
-    if (osFullName == NULL) {
-        return EMPTY_STR;
+    char composed[COMPOSED_MAX_LEN] = {0};
+    if ((len > sizeof(composed)) || (compose(composed, len) != EC_SUCCESS)) {
+        return NULL;
+    }
+#ifndef __LITEOS_M__
+    (void)pthread_mutex_lock(&g_composeLock);
+#endif
+    int expected = COMPOSE_FREE;
+    if (__atomic_compare_exchange_n(state, &expected, COMPOSE_COPYING, FALSE, __ATOMIC_ACQUIRE,
+        __ATOMIC_ACQUIRE)) {
+        (void)memcpy_s(value, len, composed, len);
+        expected = COMPOSE_READY;
+        __atomic_store_n(state, COMPOSE_READY, __ATOMIC_RELEASE);
     }
-    return osFullName;
+#ifndef __LITEOS_M__
+    (void)pthread_mutex_unlock(&g_composeLock);
+#endif
+    return (expected == COMPOSE_READY) ? value : NULL;
 }
 
-static const char *BuildDisplayVersion(void)
+static int BuildDisplayVersion(char *displayValue, unsigned int displayLen)
 {
     int len;
     char patchValue[OHOS_PATCH_VERSION_LEN] = {0};
-    char displayValue[OHOS_DISPLAY_VERSION_LEN] = {0};
     int fd = open(OHOS_PATCH_VERSION_FILE, O_RDONLY);
     if (fd < 0) {
-        return NULL;
+        return EC_FAILURE;
     }
     len = read(fd, patchValue, OHOS_PATCH_VERSION_LEN);
     if (len < strlen("version=")) {
         close(fd);
-        return NULL;
+        return EC_FAILURE;
     }
     close(fd);
     if (patchValue[len - 1] == '\n') {
@@ -213,32 +360,29 @@ static const char *BuildDisplayVersion(void)
     const int versionLen = strlen(versionValue);
     if (versionLen > 0) {
         if (versionValue[versionLen - 1] != ')') {
-            len = sprintf_s(displayValue, OHOS_DISPLAY_VERSION_LEN, "%s(%s)", versionValue,
+            len = sprintf_s(displayValue, displayLen, "%s(%s)", versionValue,
                 patchValue + strlen("version="));
         } else {
             char tempValue[versionLen];
             memset_s(tempValue, versionLen, 0, versionLen);
             if (strncpy_s(tempValue, versionLen, versionValue, versionLen - 1) != 0) {
-                return NULL;
+                return EC_FAILURE;
             }
             tempValue[versionLen - 1] = '\0';
-            len = sprintf_s(displayValue, OHOS_DISPLAY_VERSION_LEN, "%s%s)", tempValue,
+            len = sprintf_s(displayValue, displayLen, "%s%s)", tempValue,
                 patchValue + strlen("version="));
         }
     }
     if (len < 0) {
-        return NULL;
+        return EC_FAILURE;
     }
-    return strdup(displayValue);
+    return EC_SUCCESS;
 }
 
 const char *GetDisplayVersion(void)
 {
-    static const char *displayVersion = NULL;
-    if (displayVersion != NULL) {
-        return displayVersion;
-    }
-    displayVersion = BuildDisplayVersion();
+    const char *displayVersion = GetComposed(g_displayVersion, sizeof(g_displayVersion),
+        &g_displayVersionReady, BuildDisplayVersion);
     if (displayVersion == NULL) {
         return HalGetDisplayVersion();
     }
@@ -260,27 +404,18 @@ const char *GetIncrementalVersion(void)
     return HalGetIncrementalVersion();
 }
 
-static const char *BuildVersionId(void)
+static int BuildVersionId(char *value, unsigned int len)
 {
-    char value[VERSION_ID_LEN];
-    int len = sprintf_s(value, VERSION_ID_LEN, "%s/%s/%s/%s/%s/%s/%s/%d/%s/%s",
+    int ret = sprintf_s(value, len, "%s/%s/%s/%s/%s/%s/%s/%d/%s/%s",
         GetDeviceType(), GetManufacture(), GetBrand(), GetProductSeries(),
-        GetOSFullName(), GetProductModel(), GetSoftwareModel(),
+        OHOS_OS_FULL_NAME, GetProductModel(), GetSoftwareModel(),
         OHOS_SDK_API_VERSION, GetIncrementalVersion(), GetBuildType());
-    if (len < 0) {
-        return EMPTY_STR;
-    }
-    const char *versionId = strdup(value);
-    return versionId;
+    return (ret < 0) ? EC_FAILURE : EC_SUCCESS;
 }
 
 const char *GetVersionId(void)
 {
-    static const char *versionId = NULL;
-    if (versionId != NULL) {
-        return versionId;
-    }
-    versionId = BuildVersionId();
+    const char *versionId = GetComposed(g_versionId, sizeof(g_versionId), &g_versionIdReady, BuildVersionId);
     if (versionId == NULL) {
         return EMPTY_STR;
     }
@@ -317,12 +452,14 @@ const char *GetOsReleaseType(void)
     return OHOS_RELEASE_TYPE;
 }
 #ifdef USE_MBEDTLS
-static int GetSha256Value(const unsigned char *input, char *udid, int udidSize)
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+/* udid receives the upper case hex digest and its terminator */
+static int GetSha256Value(const unsigned char *input, char *udid, unsigned int udidSize)
 {
-    if (input == NULL) {
+    if ((input == NULL) || (udidSize < DEV_UUID_LENGTH)) {
         return EC_FAILURE;
     }
-    char buf[DEV_BUF_LENGTH] = { 0 };
     unsigned char hash[HASH_LENGTH] = { 0 };
 
     mbedtls_sha256_context context;
@@ -332,22 +469,15 @@ static int GetSha256Value(const unsigned char *input, char *udid, int udidSize)
     mbedtls_sha256_finish_ret(&context, hash);
 
     for (size_t i = 0; i < HASH_LENGTH; i++) {
-        unsigned char value = hash[i];
-        memset_s(buf, DEV_BUF_LENGTH, 0, DEV_BUF_LENGTH);
-        sprintf_s(buf, sizeof(buf), "%02X", value);
-        if (strcat_s(udid, udidSize, buf) != 0) {
-            return EC_FAILURE;
-        }
+        udid[i * 2] = HEX_DIGITS[hash[i] >> HEX_HIGH_SHIFT]; /* 2: hex digits per byte */
+        udid[i * 2 + 1] = HEX_DIGITS[hash[i] & HEX_LOW_MASK]; /* 2: hex digits per byte */
     }
+    udid[HASH_LENGTH * 2] = '\0'; /* 2: hex digits per byte */
     return EC_SUCCESS;
 }
 
-int GetDevUdid(char *udid, int size)
+static int BuildDevUdid(char *udid, unsigned int size)
 {
-    if (size < DEV_UUID_LENGTH) {
-        return EC_FAILURE;
-    }
-
     const char *manufacture = GetManufacture();
     const char *model = GetProductModel();
     const char *sn = GetSerial();
@@ -375,6 +505,18 @@ int GetDevUdid(char *udid, int size)
     free(tmp);
     return ret;
 }
+
+int GetDevUdid(char *udid, int size)
+{
+    if ((udid == NULL) || (size < DEV_UUID_LENGTH)) {
+        return EC_FAILURE;
+    }
+    const char *devUdid = GetComposed(g_devUdid, sizeof(g_devUdid), &g_devUdidReady, BuildDevUdid);
+    if (devUdid == NULL) {
+        return EC_FAILURE;
+    }
+    return (memcpy_s(udid, size, devUdid, DEV_UUID_LENGTH) == 0) ? EC_SUCCESS : EC_FAILURE;
+}
 #else
 int GetDevUdid(char *udid, int size)
 {
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_txn.h"
+
+using namespace testing::ext;
+
+/*
+ * The arena backend is built into this test with DATA_PATH pointing to a directory of its own.
+ * The arena is mapped once per process, so every scenario runs in a child process of its own.
+ */
+namespace OHOS {
+namespace {
+const char ARENA_FILE[] = DATA_PATH "PARAM_ARENA";
+const char ARENA_TXN_FILE[] = DATA_PATH "PARAM_ARENA.TXN";
+const off_t BATCH_SERIAL_OFFSET = 20; /* 20: magic, version, slotCount, slotSize and keyCount before it */
+const int VALUE_LEN = 128;
+
+void ClearDataDir()
+{
+    (void)mkdir(DATA_PATH, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    DIR *dir = opendir(DATA_PATH);
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] != '.') {
+            (void)unlinkat(dirfd(dir), entry->d_name, 0);
+        }
+    }
+    closedir(dir);
+}
+
+int WriteFile(const char *path, const char *data, size_t len)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t ret = write(fd, data, len);
+    close(fd);
+    return (ret == static_cast<ssize_t>(len)) ? 0 : -1;
+}
+
+bool HasValue(const char *key, const char *expected)
+{
+    char value[VALUE_LEN] = {0};
+    return (GetSysParam(key, value, sizeof(value)) == static_cast<int>(strlen(expected))) &&
+        (strcmp(value, expected) == 0);
+}
+
+/* An arena laid out for fewer slots is rebuilt from the per-file parameters */
+int RebuildSmallArena()
+{
+    const char legacy[] = "legacy";
+    if ((WriteFile(ARENA_FILE, "PARA", strlen("PARA")) != 0) ||
+        (WriteFile(DATA_PATH "rw.sys.arena.legacy", legacy, strlen(legacy)) != 0)) {
+        return 1;
+    }
+    if (!HasValue("rw.sys.arena.legacy", legacy)) {
+        return 2; /* 2: the arena was not rebuilt */
+    }
+    /* 3: the rebuilt arena is read only */
+    return (SetSysParam("rw.sys.arena.legacy", "new") == EC_SUCCESS) ? 0 : 3;
+}
+
+int StoreOldValue()
+{
+    return (SetSysParam("rw.sys.arena.txn", "old") == EC_SUCCESS) ? 0 : 1;
+}
+
+int CommitBatchLog()
+{
+    const char *keys[] = { "rw.sys.arena.txn" };
+    const char *values[] = { "new" };
+    return (ParamTxnLogWrite(ARENA_TXN_FILE, keys, values, 1) == EC_SUCCESS) ? 0 : 1;
+}
+
+/* The committed batch of a writer that died is finished when the arena is mapped */
+int RecoverCommittedBatch()
+{
+    if (!HasValue("rw.sys.arena.txn", "new")) {
+        return 1;
+    }
+    return (access(ARENA_TXN_FILE, F_OK) != 0) ? 0 : 2; /* 2: the log was left behind */
+}
+
+/* A batch left open by a writer that died is finished by the reader that waits for it */
+int ReadOpenBatch()
+{
+    if (!HasValue("rw.sys.arena.txn", "old") || (CommitBatchLog() != 0)) {
+        return 1;
+    }
+    int fd = open(ARENA_FILE, O_RDWR);
+    uint32_t serial = 1;
+    ssize_t ret = (fd < 0) ? -1 : pwrite(fd, &serial, sizeof(serial), BATCH_SERIAL_OFFSET);
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (ret != static_cast<ssize_t>(sizeof(serial))) {
+        return 2; /* 2: the batch could not be opened */
+    }
+    char value[VALUE_LEN] = {0};
+    ParameterItem item = { "rw.sys.arena.txn", nullptr, value, sizeof(value), 0 };
+    if ((GetSysParams(&item, 1) != EC_SUCCESS) || (strcmp(value, "new") != 0)) {
+        return 3; /* 3: the batch was read half done */
+    }
+    return (access(ARENA_TXN_FILE, F_OK) != 0) ? 0 : 4; /* 4: the log was left behind */
+}
+}  // namespace
+
+class ParamArenaTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase()
+    {
+        ClearDataDir();
+    }
+    void SetUp()
+    {
+        ClearDataDir();
+    }
+    void TearDown() {}
+};
+
+HWTEST_F(ParamArenaTest, paramArenaTest001, TestSize.Level0)
+{
+    EXPECT_EXIT(_exit(RebuildSmallArena()), testing::ExitedWithCode(0), "");
+    struct stat info = {};
+    ASSERT_EQ(stat(ARENA_FILE, &info), 0);
+    EXPECT_GT(info.st_size, static_cast<off_t>(strlen("PARA")));
+}
+
+HWTEST_F(ParamArenaTest, paramArenaTest002, TestSize.Level0)
+{
+    EXPECT_EXIT(_exit(StoreOldValue()), testing::ExitedWithCode(0), "");
+    ASSERT_EQ(CommitBatchLog(), 0);
+    EXPECT_EXIT(_exit(RecoverCommittedBatch()), testing::ExitedWithCode(0), "");
+}
+
+HWTEST_F(ParamArenaTest, paramArenaTest003, TestSize.Level0)
+{
+    EXPECT_EXIT(_exit(StoreOldValue()), testing::ExitedWithCode(0), "");
+    EXPECT_EXIT(_exit(ReadOpenBatch()), testing::ExitedWithCode(0), "");
+}
+}  // namespace OHOS
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_adaptor.h"
+#include "param_bloom.h"
+
+using namespace testing::ext;
+
+/*
+ * The per-file backend is built into this test with every optional feature enabled,
+ * and DATA_PATH pointing to a directory of its own.
+ */
+namespace OHOS {
+namespace {
+const int POLL_US = 10000;
+const int POLL_COUNT = 100;
+const int VALUE_LEN = 128;
+
+void ClearDataDir()
+{
+    (void)mkdir(DATA_PATH, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    DIR *dir = opendir(DATA_PATH);
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] != '.') {
+            (void)unlinkat(dirfd(dir), entry->d_name, 0);
+        }
+    }
+    closedir(dir);
+}
+
+/* Stores value the way another process would, behind the back of this one */
+int WriteExternally(const char *key, const char *value)
+{
+    char path[VALUE_LEN] = {0};
+    if (snprintf(path, sizeof(path), "%s%s", DATA_PATH, key) < 0) {
+        return -1;
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t ret = write(fd, value, strlen(value));
+    close(fd);
+    return (ret == static_cast<ssize_t>(strlen(value))) ? 0 : -1;
+}
+
+bool HasValue(const char *key, const char *expected)
+{
+    char value[VALUE_LEN] = {0};
+    return (GetSysParam(key, value, sizeof(value)) >= 0) && (strcmp(value, expected) == 0);
+}
+
+struct SiblingWatch {
+    int calls;
+    SiblingWatch *sibling;
+};
+
+/* Each watcher cancels the other one, whichever of them runs first */
+void CancelSibling(const char *key, const char *value, void *context)
+{
+    (void)key;
+    (void)value;
+    SiblingWatch *watch = static_cast<SiblingWatch *>(context);
+    __atomic_add_fetch(&watch->calls, 1, __ATOMIC_RELEASE);
+    (void)WatchSysParam("rw.sys.sibling.", nullptr, watch->sibling);
+}
+
+bool WaitForValue(const char *key, const char *expected)
+{
+    for (int i = 0; i < POLL_COUNT; i++) {
+        if (HasValue(key, expected)) {
+            return true;
+        }
+        usleep(POLL_US);
+    }
+    return false;
+}
+}  // namespace
+
+class ParamPosixTest : public testing::Test {
+public:
+    static void SetUpTestCase()
+    {
+        ClearDataDir();
+    }
+    static void TearDownTestCase()
+    {
+        ClearDataDir();
+    }
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(ParamPosixTest, paramPosixTest001, TestSize.Level0)
+{
+    ASSERT_EQ(SetSysParam("rw.sys.cache.local", "1"), EC_SUCCESS);
+    EXPECT_TRUE(HasValue("rw.sys.cache.local", "1"));
+    EXPECT_TRUE(HasValue("rw.sys.cache.local", "1"));
+
+    /* A write of this process evicts the cached value before it returns */
+    ASSERT_EQ(SetSysParam("rw.sys.cache.local", "2"), EC_SUCCESS);
+    EXPECT_TRUE(HasValue("rw.sys.cache.local", "2"));
+}
+
+HWTEST_F(ParamPosixTest, paramPosixTest002, TestSize.Level0)
+{
+    ASSERT_EQ(SetSysParam("rw.sys.cache.external", "1"), EC_SUCCESS);
+    EXPECT_TRUE(HasValue("rw.sys.cache.external", "1"));
+
+    /* A write of another process evicts it once inotify delivered the event */
+    ASSERT_EQ(WriteExternally("rw.sys.cache.external", "2"), 0);
+    EXPECT_TRUE(WaitForValue("rw.sys.cache.external", "2"));
+}
+
+HWTEST_F(ParamPosixTest, paramPosixTest003, TestSize.Level0)
+{
+    char value[VALUE_LEN] = {0};
+    ParamBloomStats before = {};
+    ParamBloomStats after = {};
+    ParamBloomGetStats(&before);
+    EXPECT_EQ(GetSysParam("rw.sys.bloom.missing", value, sizeof(value)), EC_FAILURE);
+    ParamBloomGetStats(&after);
+    EXPECT_EQ(after.lookups, before.lookups + 1);
+    EXPECT_EQ(after.negativeHits, before.negativeHits + 1);
+    EXPECT_EQ(after.falsePositives, before.falsePositives);
+
+    /* A key stored by this process is let through at once */
+    ASSERT_EQ(SetSysParam("rw.sys.bloom.local", "1"), EC_SUCCESS);
+    ParamBloomGetStats(&before);
+    EXPECT_TRUE(HasValue("rw.sys.bloom.local", "1"));
+    ParamBloomGetStats(&after);
+    EXPECT_EQ(after.lookups, before.lookups + 1);
+    EXPECT_EQ(after.negativeHits, before.negativeHits);
+}
+
+HWTEST_F(ParamPosixTest, paramPosixTest004, TestSize.Level0)
+{
+    /* A key created by another process is let through once inotify delivered the event */
+    ASSERT_EQ(WriteExternally("rw.sys.bloom.external", "1"), 0);
+    EXPECT_TRUE(WaitForValue("rw.sys.bloom.external", "1"));
+
+    /* A file removed behind the back of the filter only costs a false positive */
+    char value[VALUE_LEN] = {0};
+    ASSERT_EQ(unlink(DATA_PATH "rw.sys.bloom.external"), 0);
+    for (int i = 0; (i < POLL_COUNT) && (GetSysParam("rw.sys.bloom.external", value, sizeof(value)) >= 0); i++) {
+        usleep(POLL_US); /* until the read cache has dropped the value */
+    }
+    ParamBloomStats before = {};
+    ParamBloomStats after = {};
+    ParamBloomGetStats(&before);
+    EXPECT_EQ(GetSysParam("rw.sys.bloom.external", value, sizeof(value)), EC_FAILURE);
+    ParamBloomGetStats(&after);
+    EXPECT_EQ(after.negativeHits, before.negativeHits);
+    EXPECT_EQ(after.falsePositives, before.falsePositives + 1);
+}
+
+HWTEST_F(ParamPosixTest, paramPosixTest005, TestSize.Level0)
+{
+    SiblingWatch first = { 0, nullptr };
+    SiblingWatch second = { 0, &first };
+    first.sibling = &second;
+    ASSERT_EQ(WatchSysParam("rw.sys.sibling.", CancelSibling, &first), EC_SUCCESS);
+    ASSERT_EQ(WatchSysParam("rw.sys.sibling.", CancelSibling, &second), EC_SUCCESS);
+
+    /* The watcher cancelled by a callback of the same change is not called any more */
+    ASSERT_EQ(SetSysParam("rw.sys.sibling.key", "1"), EC_SUCCESS);
+    for (int i = 0; (i < POLL_COUNT) && (__atomic_load_n(&first.calls, __ATOMIC_ACQUIRE) +
+        __atomic_load_n(&second.calls, __ATOMIC_ACQUIRE) == 0); i++) {
+        usleep(POLL_US);
+    }
+    usleep(POLL_US);
+    EXPECT_EQ(__atomic_load_n(&first.calls, __ATOMIC_ACQUIRE) + __atomic_load_n(&second.calls, __ATOMIC_ACQUIRE), 1);
+
+    SiblingWatch *left = (first.calls == 0) ? &second : &first;
+    EXPECT_EQ(WatchSysParam("rw.sys.sibling.", nullptr, left), EC_SUCCESS);
+}
+}  // namespace OHOS
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "param_seq.h"
+
+using namespace testing::ext;
+
+/*
+ * The sequence table is built into this test with DATA_PATH pointing to a directory of its own.
+ * The table is mapped once per process, so every process mapping it is a child of the test.
+ */
+namespace OHOS {
+namespace {
+const uid_t UNPRIVILEGED_UID = 65534; /* nobody, that can not open the table for writing */
+const unsigned int WRITER_TIMEOUT = 5; /* seconds */
+
+void ClearDataDir()
+{
+    (void)mkdir(DATA_PATH, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    DIR *dir = opendir(DATA_PATH);
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] != '.') {
+            (void)unlinkat(dirfd(dir), entry->d_name, 0);
+        }
+    }
+    closedir(dir);
+}
+
+int MapTable()
+{
+    uint32_t seq = 0;
+    return (ParamSeqGet("", &seq) == EC_SUCCESS) ? 0 : 1;
+}
+
+/* Maps the table read-only, tells the test how it went, then keeps it mapped until killed */
+void RunReader(int reportFd)
+{
+    char mapped = ((setuid(UNPRIVILEGED_UID) == 0) && (MapTable() == 0)) ? 1 : 0;
+    (void)write(reportFd, &mapped, sizeof(mapped));
+    while (1) {
+        (void)pause();
+    }
+}
+
+/* A writer stuck on the lock of the table is killed by the alarm */
+int MapTableInTime()
+{
+    (void)alarm(WRITER_TIMEOUT);
+    return MapTable();
+}
+}  // namespace
+
+class ParamSeqTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase()
+    {
+        ClearDataDir();
+    }
+    void SetUp()
+    {
+        ClearDataDir();
+    }
+    void TearDown() {}
+};
+
+HWTEST_F(ParamSeqTest, paramSeqTest001, TestSize.Level0)
+{
+    EXPECT_EXIT(_exit(MapTable()), testing::ExitedWithCode(0), "");
+    int report[2] = { -1, -1 };
+    ASSERT_EQ(pipe(report), 0);
+    pid_t reader = fork();
+    ASSERT_GE(reader, 0);
+    if (reader == 0) {
+        RunReader(report[1]);
+    }
+    char mapped = 0;
+    ssize_t len = read(report[0], &mapped, sizeof(mapped));
+    close(report[0]);
+    close(report[1]);
+    if ((len != static_cast<ssize_t>(sizeof(mapped))) || (mapped == 0)) {
+        (void)kill(reader, SIGKILL);
+        (void)waitpid(reader, nullptr, 0);
+        GTEST_SKIP() << "the data path can not be mapped by an unprivileged process";
+    }
+
+    /* A process mapping the table read-only never keeps the next writer out of it */
+    EXPECT_EXIT(_exit(MapTableInTime()), testing::ExitedWithCode(0), "");
+    (void)kill(reader, SIGKILL);
+    (void)waitpid(reader, nullptr, 0);
+}
+}  // namespace OHOS
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ohos_errno.h"
+#include "parameter.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+const int BENCH_UPDATES = 2000;
+const int BENCH_READS = 20000;
+const int MAX_KEY_PATH = 128;
+const int BENCH_VALUE_LEN = 32;
+const char BENCH_KEY[] = "rw.bench.toggle";
+const char DATA_PATH[] = "/storage/data/system/param/";
+const char PER_FILE_PATH[] = "/storage/data/system/param/rw.bench.perfile";
+
+struct IoCounters {
+    long long wchar; /* bytes handed to write() */
+    long long writeBytes; /* bytes sent to the storage, what wears the flash */
+};
+
+/* -1 where the kernel does not account I/O per task */
+IoCounters ReadIoCounters()
+{
+    IoCounters counters = { -1, -1 };
+    sync();
+    FILE *file = fopen("/proc/self/io", "r");
+    if (file == nullptr) {
+        return counters;
+    }
+    char line[64] = {0};
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        (void)sscanf(line, "wchar: %lld", &counters.wchar);
+        (void)sscanf(line, "write_bytes: %lld", &counters.writeBytes);
+    }
+    (void)fclose(file);
+    return counters;
+}
+
+/* What the per-file backend does for every SetParameter: truncate the key file and write it again */
+int PerFileSet(const char *value)
+{
+    int fd = open(PER_FILE_PATH, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    ssize_t ret = write(fd, value, strlen(value));
+    close(fd);
+    return (ret < 0) ? EC_FAILURE : EC_SUCCESS;
+}
+
+/* The read path as it was before the data directory was cached: heap path, stat, then open */
+int LegacyGet(const char *key, char *value, unsigned int len)
+{
+    char *keyPath = static_cast<char *>(malloc(MAX_KEY_PATH + 1));
+    if (keyPath == nullptr) {
+        return EC_FAILURE;
+    }
+    if (snprintf(keyPath, MAX_KEY_PATH + 1, "%s%s", DATA_PATH, key) < 0) {
+        free(keyPath);
+        return EC_FAILURE;
+    }
+    struct stat info = {0};
+    if ((stat(keyPath, &info) != 0) || (info.st_size >= len)) {
+        free(keyPath);
+        return EC_FAILURE;
+    }
+    int fd = open(keyPath, O_RDONLY);
+    free(keyPath);
+    if (fd < 0) {
+        return EC_FAILURE;
+    }
+    ssize_t ret = read(fd, value, static_cast<size_t>(info.st_size));
+    close(fd);
+    if (ret < 0) {
+        return EC_FAILURE;
+    }
+    value[ret] = '\0';
+    return static_cast<int>(ret);
+}
+
+long long NanosPerCall(std::chrono::steady_clock::duration elapsed, int calls)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / calls;
+}
+
+void MakeValue(int i, char *value)
+{
+    (void)snprintf(value, BENCH_VALUE_LEN, "toggle.value.%08d", i);
+}
+
+void Report(const char *name, std::chrono::steady_clock::duration elapsed, const IoCounters &start)
+{
+    long long micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    IoCounters end = ReadIoCounters();
+    printf("%-10s %8lld updates/s", name, (micros > 0) ? (BENCH_UPDATES * 1000000LL / micros) : 0);
+    if ((start.wchar >= 0) && (end.wchar >= 0)) {
+        printf(", %lld bytes written per update", (end.wchar - start.wchar) / BENCH_UPDATES);
+    }
+    if ((start.writeBytes >= 0) && (end.writeBytes >= 0)) {
+        printf(", %lld bytes to storage per update", (end.writeBytes - start.writeBytes) / BENCH_UPDATES);
+    }
+    printf("\n");
+}
+}  // namespace
+
+class ParameterBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase()
+    {
+        printf("----------benchmark with parameter start-------------\n");
+    }
+    static void TearDownTestCase()
+    {
+        (void)unlink(PER_FILE_PATH);
+        printf("----------benchmark with parameter end---------------\n");
+    }
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/*
+ * Toggles one key many times through SetParameter and through a replica of the per-file write path,
+ * which is what SetParameter costs when the "file" storage is configured. With the "journal" storage,
+ * the size the log grew by is reported as well, compaction included.
+ */
+HWTEST_F(ParameterBenchmarkTest, parameterBenchmark001, TestSize.Level3)
+{
+    char value[BENCH_VALUE_LEN] = {0};
+    char valueGet[BENCH_VALUE_LEN] = {0};
+    (void)GetParameter(BENCH_KEY, "", valueGet, sizeof(valueGet)); /* opens the storage before it is measured */
+    IoCounters counters = ReadIoCounters();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_UPDATES; i++) {
+        MakeValue(i, value);
+        ASSERT_EQ(PerFileSet(value), EC_SUCCESS);
+    }
+    Report("per-file", std::chrono::steady_clock::now() - start, counters);
+
+    std::string journal = std::string(DATA_PATH) + "PARAM_JOURNAL";
+    struct stat before = {0};
+    bool hasJournal = (stat(journal.c_str(), &before) == 0);
+    counters = ReadIoCounters();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_UPDATES; i++) {
+        MakeValue(i, value);
+        ASSERT_EQ(SetParameter(BENCH_KEY, value), EC_SUCCESS);
+    }
+    Report("configured", std::chrono::steady_clock::now() - start, counters);
+
+    struct stat after = {0};
+    if (hasJournal && (stat(journal.c_str(), &after) == 0)) {
+        printf("journal grew by %lld bytes\n", static_cast<long long>(after.st_size - before.st_size));
+    }
+    EXPECT_EQ(GetParameter(BENCH_KEY, "", valueGet, sizeof(valueGet)), static_cast<int>(strlen(value)));
+    EXPECT_STREQ(valueGet, value);
+}
+
+/* Hot read path: the same existing key read over and over, before and after the cached directory fd */
+HWTEST_F(ParameterBenchmarkTest, parameterBenchmark002, TestSize.Level3)
+{
+    const char key[] = "rw.bench.read";
+    ASSERT_EQ(SetParameter(key, "hot read path"), EC_SUCCESS);
+    char value[BENCH_VALUE_LEN] = {0};
+    ASSERT_GT(GetParameter(key, "", value, sizeof(value)), 0);
+    bool legacyReadable = (LegacyGet(key, value, sizeof(value)) > 0);
+
+    if (legacyReadable) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_READS; i++) {
+            ASSERT_GT(LegacyGet(key, value, sizeof(value)), 0);
+        }
+        printf("%-10s %8lld ns per read\n", "legacy", NanosPerCall(std::chrono::steady_clock::now() - start,
+            BENCH_READS));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_READS; i++) {
+        ASSERT_GT(GetParameter(key, "", value, sizeof(value)), 0);
+    }
+    printf("%-10s %8lld ns per read\n", "configured", NanosPerCall(std::chrono::steady_clock::now() - start,
+        BENCH_READS));
+    EXPECT_STREQ(value, "hot read path");
+}
+}  // namespace OHOS
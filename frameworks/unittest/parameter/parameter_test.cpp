@@ -17,12 +17,43 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "ohos_errno.h"
 #include "parameter.h"
 
 using namespace testing::ext;
 
 namespace OHOS {
+namespace {
+const int WATCH_POLL_US = 10000;
+const int WATCH_POLL_COUNT = 100;
+const int HANDLE_BUF_LEN = 64;
+
+void OnWatchedChange(const char *key, const char *value, void *context)
+{
+    if ((strcmp(key, "rw.sys.watch.version") == 0) && (strcmp(value, "10.2.0") == 0)) {
+        __atomic_add_fetch(static_cast<int *>(context), 1, __ATOMIC_RELEASE);
+    }
+}
+
+int CountVisited(const char *key, const char *value, void *context)
+{
+    if ((strncmp(key, "rw.sys.each.", strlen("rw.sys.each.")) == 0) && (strcmp(value, "1") == 0)) {
+        (*static_cast<int *>(context))++;
+    }
+    return 0;
+}
+
+int StopVisit(const char *key, const char *value, void *context)
+{
+    (void)key;
+    (void)value;
+    (*static_cast<int *>(context))++;
+    return 1;
+}
+}  // namespace
+
 class ParameterTest : public testing::Test {
 public:
     static void SetUpTestCase()
@@ -179,4 +210,196 @@ HWTEST_F(ParameterTest, parameterTest0010, TestSize.Level0)
     ret = GetParameter(key4, "version=10.1.0", valueGet4, 32);
     EXPECT_EQ(ret, strlen(valueGet4));
 }
+
+HWTEST_F(ParameterTest, parameterTest0011, TestSize.Level0)
+{
+    char key1[] = "rw.sys.version";
+    int ret = SetParameter(key1, "10.1.0");
+    EXPECT_EQ(ret, 0);
+
+    char valueGet1[32] = {0};
+    char valueGet2[32] = {0};
+    char valueGet3[2] = {0};
+    char valueGet4[32] = {0};
+    char defValue2[] = "value of key not exist...";
+    ParameterItem items[] = {
+        { key1, nullptr, valueGet1, sizeof(valueGet1), 0 },
+        { "rw.product.not.exist", defValue2, valueGet2, sizeof(valueGet2), 0 },
+        { key1, nullptr, valueGet3, sizeof(valueGet3), 0 },
+        { "rw.sys.version*%version", nullptr, valueGet4, sizeof(valueGet4), 0 },
+    };
+    ret = GetParameters(items, sizeof(items) / sizeof(items[0]));
+    EXPECT_EQ(ret, 2);
+    EXPECT_STREQ(valueGet1, "10.1.0");
+    EXPECT_EQ(items[0].ret, strlen(valueGet1));
+    EXPECT_STREQ(valueGet2, defValue2);
+    EXPECT_EQ(items[1].ret, strlen(defValue2));
+    EXPECT_EQ(items[2].ret, EC_INVALID);
+    EXPECT_EQ(items[3].ret, EC_INVALID);
+
+    ret = GetParameters(nullptr, 1);
+    EXPECT_EQ(ret, EC_INVALID);
+}
+
+HWTEST_F(ParameterTest, parameterTest0012, TestSize.Level0)
+{
+    const char *keys[] = { "rw.sys.batch.version", "rw.sys.batch.type" };
+    const char *values[] = { "10.1.0", "wifi_iot" };
+    int ret = SetParameters(keys, values, 2);
+    EXPECT_EQ(ret, 0);
+    char valueGet1[32] = {0};
+    ret = GetParameter(keys[0], "", valueGet1, 32);
+    EXPECT_STREQ(valueGet1, values[0]);
+    char valueGet2[32] = {0};
+    ret = GetParameter(keys[1], "", valueGet2, 32);
+    EXPECT_STREQ(valueGet2, values[1]);
+
+    /* one invalid key rejects the whole batch */
+    const char *badKeys[] = { "rw.sys.batch.version", "rw.sys.version*%version" };
+    const char *badValues[] = { "10.2.0", "set value with illegal key" };
+    ret = SetParameters(badKeys, badValues, 2);
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = GetParameter(keys[0], "", valueGet1, 32);
+    EXPECT_STREQ(valueGet1, values[0]);
+
+    const char *roKeys[] = { "ro.sys.version" };
+    ret = SetParameters(roKeys, values, 1);
+    EXPECT_EQ(ret, EC_INVALID);
+}
+
+HWTEST_F(ParameterTest, parameterTest0013, TestSize.Level0)
+{
+    char key[] = "rw.sys.wait.version";
+    int ret = SetParameter(key, "10.1.0");
+    EXPECT_EQ(ret, 0);
+    ret = WaitParameter(key, "10.1.0", 1);
+    EXPECT_EQ(ret, 0);
+    ret = WaitParameter(key, "*", 1);
+    EXPECT_EQ(ret, 0);
+
+    ret = WaitParameter(key, "10.2.0", 1);
+    EXPECT_EQ(ret, EC_TIMEOUT);
+    ret = WaitParameter("rw.sys.wait.missing", "*", 1);
+    EXPECT_EQ(ret, EC_TIMEOUT);
+
+    ret = WaitParameter(nullptr, "*", 1);
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = WaitParameter("rw.sys.version*%version", "*", 1);
+    EXPECT_EQ(ret, EC_INVALID);
+}
+
+HWTEST_F(ParameterTest, parameterTest0014, TestSize.Level0)
+{
+    int ret = WatchParameter(nullptr, OnWatchedChange, nullptr);
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = WatchParameter("rw.sys.version*%", OnWatchedChange, nullptr);
+    EXPECT_EQ(ret, EC_INVALID);
+
+    int changes = 0;
+    ret = SetParameter("rw.sys.watch.version", "10.1.0");
+    EXPECT_EQ(ret, 0);
+    ret = WatchParameter("rw.sys.watch.", OnWatchedChange, &changes);
+    if (ret != 0) {
+        GTEST_SKIP() << "WatchParameter is not supported by the configured storage";
+    }
+    ret = SetParameter("rw.sys.watch.version", "10.2.0");
+    EXPECT_EQ(ret, 0);
+    for (int i = 0; (i < WATCH_POLL_COUNT) && (__atomic_load_n(&changes, __ATOMIC_ACQUIRE) == 0); i++) {
+        usleep(WATCH_POLL_US);
+    }
+    EXPECT_EQ(__atomic_load_n(&changes, __ATOMIC_ACQUIRE), 1);
+
+    ret = WatchParameter("rw.sys.watch.", nullptr, &changes);
+    EXPECT_EQ(ret, 0);
+    ret = WatchParameter("rw.sys.watch.", nullptr, &changes);
+    EXPECT_EQ(ret, EC_FAILURE);
+}
+
+HWTEST_F(ParameterTest, parameterTest0015, TestSize.Level0)
+{
+    int visited = 0;
+    int ret = ForEachParameter(nullptr, CountVisited, &visited);
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = ForEachParameter("rw.sys.each.", nullptr, &visited);
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = ForEachParameter("rw.sys.each*%", CountVisited, &visited);
+    EXPECT_EQ(ret, EC_INVALID);
+
+    const char *keys[] = { "rw.sys.each.first", "rw.sys.each.second", "rw.sys.other" };
+    const char *values[] = { "1", "1", "1" };
+    ret = SetParameters(keys, values, sizeof(keys) / sizeof(keys[0]));
+    EXPECT_EQ(ret, 0);
+    ret = ForEachParameter("rw.sys.each.", CountVisited, &visited);
+    if (ret == EC_FAILURE) {
+        GTEST_SKIP() << "ForEachParameter is not supported by the configured storage";
+    }
+    EXPECT_EQ(ret, 2);
+    EXPECT_EQ(visited, 2);
+
+    visited = 0;
+    ret = ForEachParameter("rw.sys.", StopVisit, &visited);
+    EXPECT_EQ(ret, 1);
+    EXPECT_EQ(visited, 1);
+    ret = ForEachParameter("rw.sys.none.", StopVisit, &visited);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(visited, 1);
+}
+
+HWTEST_F(ParameterTest, parameterTest0016, TestSize.Level0)
+{
+    const unsigned int invalidHandle = static_cast<unsigned int>(-1);
+    EXPECT_EQ(FindParameter(nullptr), invalidHandle);
+    EXPECT_EQ(FindParameter("rw.sys.handle.missing"), invalidHandle);
+
+    int ret = SetParameter("rw.sys.handle.key", "first");
+    EXPECT_EQ(ret, 0);
+    unsigned int handle = FindParameter("rw.sys.handle.key");
+    if (handle == invalidHandle) {
+        GTEST_SKIP() << "FindParameter is not supported by the configured storage";
+    }
+    EXPECT_EQ(FindParameter("rw.sys.handle.key"), handle);
+
+    char buffer[HANDLE_BUF_LEN] = {0};
+    ret = GetParameterName(handle, buffer, HANDLE_BUF_LEN);
+    EXPECT_EQ(ret, static_cast<int>(strlen("rw.sys.handle.key")));
+    EXPECT_STREQ(buffer, "rw.sys.handle.key");
+    ret = GetParameterValue(handle, buffer, HANDLE_BUF_LEN);
+    EXPECT_EQ(ret, static_cast<int>(strlen("first")));
+    EXPECT_STREQ(buffer, "first");
+
+    unsigned int commitId = GetParameterCommitId(handle);
+    EXPECT_NE(commitId, invalidHandle);
+    EXPECT_EQ(GetParameterCommitId(handle), commitId);
+    ret = SetParameter("rw.sys.handle.key", "second");
+    EXPECT_EQ(ret, 0);
+    EXPECT_NE(GetParameterCommitId(handle), commitId);
+    ret = GetParameterValue(handle, buffer, HANDLE_BUF_LEN);
+    EXPECT_STREQ(buffer, "second");
+
+    EXPECT_EQ(GetParameterCommitId(handle + 1000), invalidHandle);
+    EXPECT_EQ(GetParameterName(handle + 1000, buffer, HANDLE_BUF_LEN), EC_INVALID);
+    EXPECT_EQ(GetParameterValue(handle, nullptr, HANDLE_BUF_LEN), EC_INVALID);
+}
+
+HWTEST_F(ParameterTest, parameterTest0017, TestSize.Level0)
+{
+    EXPECT_EQ(GetParameterSequence(nullptr), EC_INVALID);
+    EXPECT_EQ(GetParameterSequence("rw.sys.seq*%"), EC_INVALID);
+
+    long long all = GetParameterSequence("");
+    if (all == EC_FAILURE) {
+        GTEST_SKIP() << "GetParameterSequence is not supported by the configured storage";
+    }
+    long long prefix = GetParameterSequence("rw.sys.seq.");
+    long long key = GetParameterSequence("rw.sys.seq.a");
+    EXPECT_GE(all, 0);
+    EXPECT_GE(prefix, 0);
+    EXPECT_EQ(GetParameterSequence("rw.sys.seq."), prefix);
+
+    int ret = SetParameter("rw.sys.seq.a", "1");
+    EXPECT_EQ(ret, 0);
+    EXPECT_NE(GetParameterSequence(""), all);
+    EXPECT_NE(GetParameterSequence("rw.sys.seq."), prefix);
+    EXPECT_NE(GetParameterSequence("rw.sys.seq.a"), key);
+}
 }  // namespace OHOS
\ No newline at end of file
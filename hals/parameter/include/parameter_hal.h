@@ -16,6 +16,8 @@
 #ifndef STARTUP_SYSPARAM_PARAMETER_HAL_API_H
 #define STARTUP_SYSPARAM_PARAMETER_HAL_API_H
 
+#include "parameter.h"
+
 #ifdef __cplusplus
 #if __cplusplus
 extern "C" {
@@ -50,10 +52,15 @@ const char *HalGetBuildTime();
 int HalGetDevUdid(char *udid, int size);
 int HalGetFirstApiVersion();
 int HalGetParameter(const char *key, const char *def, char *value, unsigned int len);
+int HalGetParameters(ParameterItem *items, unsigned int count);
+int HalGetParameterById(unsigned int id, const char *def, char *value, unsigned int len);
 int HalSetParameter(const char *key, const char *value);
+int HalSetParameters(const char *keys[], const char *values[], unsigned int count);
 int HalGetIntParameter(const char *key, int def);
 
 int HalWaitParameter(const char *key, const char *value, int timeout);
+int HalForEachParameter(const char *prefix, ParameterVisitor visitor, void *context);
+long long HalGetParameterSequence(const char *prefix);
 unsigned int HalFindParameter(const char *name);
 unsigned int HalGetParameterCommitId(unsigned int handle);
 int HalGetParameterName(unsigned int handle, char *name, unsigned int len);
@@ -0,0 +1,211 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Copyright (c) 2021 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generates the ParamKeyId enum and a minimal perfect hash of the well-known parameter keys.
+
+The hash is built with hash and displace: keys are spread over buckets by one hash, then
+every bucket, largest first, gets the smallest displacement that sends all of its keys to
+free slots. A lookup costs one pass over the key and a single string compare.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+GOLDEN_RATIO = 0x9E3779B9
+MASK32 = 0xFFFFFFFF
+MAX_DISPLACEMENT = 0xFFFF
+KEY_PATTERN = re.compile(r'^[a-z0-9_.]+$')
+
+LICENSE = '''/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Generated by gen_param_keys.py from {manifest}, do not edit. */
+'''
+
+TABLE_FUNCTIONS = '''static inline uint32_t ParamKeyMix(uint32_t hash)
+{{
+    hash ^= hash >> 16; /* 16: murmur3 finalizer */
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13; /* 13: murmur3 finalizer */
+    hash *= 0xC2B2AE35U;
+    hash ^= hash >> 16; /* 16: murmur3 finalizer */
+    return hash;
+}}
+
+/* Returns the ParamKeyId of key, or -1 when key is not in the manifest */
+static inline int ParamKeyLookup(const char *key)
+{{
+    uint32_t hash = {offset}U;
+    for (const char *ch = key; *ch != '\\0'; ch++) {{
+        hash = (hash ^ (unsigned char)*ch) * {prime}U;
+    }}
+    uint32_t bucket = ParamKeyMix(hash) % PARAM_KEY_BUCKETS;
+    uint32_t displacement = PARAM_KEY_DISPLACEMENTS[bucket];
+    int id = PARAM_KEY_SLOTS[ParamKeyMix(hash ^ (displacement * {golden}U)) % PARAM_KEY_COUNT];
+    return (strcmp(PARAM_KEY_NAMES[id], key) == 0) ? id : -1;
+}}
+'''
+
+
+def fnv1a(key):
+    value = FNV_OFFSET_BASIS
+    for ch in key:
+        value = ((value ^ ord(ch)) * FNV_PRIME) & MASK32
+    return value
+
+
+def mix(value):
+    value ^= value >> 16
+    value = (value * 0x85EBCA6B) & MASK32
+    value ^= value >> 13
+    value = (value * 0xC2B2AE35) & MASK32
+    value ^= value >> 16
+    return value
+
+
+def slot_of(value, displacement, count):
+    return mix(value ^ ((displacement * GOLDEN_RATIO) & MASK32)) % count
+
+
+def read_manifest(path):
+    keys = []
+    with open(path, 'r') as manifest:
+        for number, line in enumerate(manifest, 1):
+            key = line.strip()
+            if not key or key.startswith('#'):
+                continue
+            if not KEY_PATTERN.match(key):
+                raise ValueError('%s:%d: invalid key "%s"' % (path, number, key))
+            if key in keys:
+                raise ValueError('%s:%d: duplicate key "%s"' % (path, number, key))
+            keys.append(key)
+    if not keys:
+        raise ValueError('%s: no key' % path)
+    return keys
+
+
+def build_perfect_hash(keys):
+    hashes = [fnv1a(key) for key in keys]
+    if len(set(hashes)) != len(hashes):
+        raise ValueError('keys collide in the 32 bit hash, no displacement can separate them')
+    count = len(keys)
+    bucket_count = (count + 1) // 2
+    while True:
+        buckets = [[] for _ in range(bucket_count)]
+        for key_id, value in enumerate(hashes):
+            buckets[mix(value) % bucket_count].append(key_id)
+        displacements = [0] * bucket_count
+        slots = [None] * count
+        placed = True
+        for bucket in sorted(range(bucket_count), key=lambda index: -len(buckets[index])):
+            members = buckets[bucket]
+            if not members:
+                continue
+            for displacement in range(1, MAX_DISPLACEMENT + 1):
+                targets = [slot_of(hashes[key_id], displacement, count) for key_id in members]
+                if len(set(targets)) == len(targets) and all(slots[target] is None for target in targets):
+                    break
+            else:
+                placed = False
+                break
+            displacements[bucket] = displacement
+            for key_id, target in zip(members, targets):
+                slots[target] = key_id
+        if placed:
+            return displacements, slots
+        bucket_count += 1
+
+
+def enum_name(key):
+    return 'PARAM_KEY_' + key.upper().replace('.', '_')
+
+
+def write_file(path, content):
+    directory = os.path.dirname(path)
+    if directory and not os.path.exists(directory):
+        os.makedirs(directory)
+    with open(path, 'w') as output:
+        output.write(content)
+
+
+def generate_ids(keys, manifest):
+    lines = [LICENSE.format(manifest=manifest)]
+    lines.append('#ifndef PARAM_KEY_IDS_H\n#define PARAM_KEY_IDS_H\n\n')
+    lines.append('typedef enum {\n')
+    for key_id, key in enumerate(keys):
+        lines.append('    %s = %d, /* %s */\n' % (enum_name(key), key_id, key))
+    lines.append('    PARAM_KEY_COUNT\n} ParamKeyId;\n\n')
+    lines.append('#endif  // PARAM_KEY_IDS_H\n')
+    return ''.join(lines)
+
+
+def generate_table(keys, manifest, ids_header):
+    displacements, slots = build_perfect_hash(keys)
+    slot_type = 'uint8_t' if len(keys) <= 0xFF else 'uint16_t'
+    lines = [LICENSE.format(manifest=manifest)]
+    lines.append('#ifndef PARAM_KEY_TABLE_H\n#define PARAM_KEY_TABLE_H\n\n')
+    lines.append('#include <stdint.h>\n#include <string.h>\n#include "%s"\n\n' % ids_header)
+    lines.append('#define PARAM_KEY_BUCKETS %d\n\n' % len(displacements))
+    lines.append('static const char * const PARAM_KEY_NAMES[PARAM_KEY_COUNT] = {\n')
+    for key in keys:
+        lines.append('    "%s",\n' % key)
+    lines.append('};\n\n')
+    lines.append('static const uint16_t PARAM_KEY_DISPLACEMENTS[PARAM_KEY_BUCKETS] = {\n')
+    lines.append('    %s\n};\n\n' % ', '.join(str(value) for value in displacements))
+    lines.append('static const %s PARAM_KEY_SLOTS[PARAM_KEY_COUNT] = {\n' % slot_type)
+    for key_id in slots:
+        lines.append('    %s,\n' % enum_name(keys[key_id]))
+    lines.append('};\n\n')
+    lines.append(TABLE_FUNCTIONS.format(offset=FNV_OFFSET_BASIS, prime=FNV_PRIME, golden=GOLDEN_RATIO))
+    lines.append('\n#endif  // PARAM_KEY_TABLE_H\n')
+    return ''.join(lines)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--manifest', required=True, help='one well-known key per line')
+    parser.add_argument('--ids-header', required=True, help='output, the ParamKeyId enum')
+    parser.add_argument('--table-header', required=True, help='output, the perfect hash of the keys')
+    args = parser.parse_args(argv)
+
+    try:
+        keys = read_manifest(args.manifest)
+        manifest = os.path.basename(args.manifest)
+        write_file(args.ids_header, generate_ids(keys, manifest))
+        write_file(args.table_header, generate_table(keys, manifest, os.path.basename(args.ids_header)))
+    except (IOError, ValueError) as error:
+        sys.stderr.write('gen_param_keys.py: %s\n' % error)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -15,11 +15,15 @@
 
 #include "parameter_hal.h"
 
+#include <atomic>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <openssl/sha.h>
 #include <securec.h>
+#include <vector>
 
+#include "param_key_table.h"
 #include "parameters.h"
 #include "sysparam_errno.h"
 #include "string_ex.h"
@@ -33,37 +37,41 @@ static const char SN_FILE[] = {"/proc/bootdevice/cid"};
 #else
 static const char SN_FILE[] = {"/sys/block/mmcblk0/device/cid"};
 #endif
-static const int DEV_BUF_LENGTH = 3;
 static const int DEV_BUF_MAX_LENGTH = 1024;
 static const int DEV_UUID_LENGTH = 65;
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+static const int HEX_HIGH_SHIFT = 4;
+static const unsigned char HEX_LOW_MASK = 0x0F;
+
+// Handles of the well-known keys, 0 until resolved and the handle plus one afterwards
+static std::atomic<unsigned int> g_keyHandles[PARAM_KEY_COUNT];
 
 static bool IsValidValue(const char *value, unsigned int len)
 {
     if (value == nullptr) {
         return false;
     }
-    const std::string strValue(value);
-    if (strValue.length() + 1 > len) {
+    if (strlen(value) + 1 > len) {
         return false;
     }
     return true;
 }
 
-int HalGetParameter(const char *key, const char *def, char *value, unsigned int len)
+static int CopyDefault(const char *def, char *value, unsigned int len)
 {
-    if ((key == nullptr) || (value == nullptr)) {
+    if (!IsValidValue(def, len)) {
         return EC_INVALID;
     }
-    const std::string strKey(key);
-    std::string res = OHOS::system::GetParameter(strKey, "");
+    if (sprintf_s(value, len, "%s", def) < 0) {
+        return EC_FAILURE;
+    }
+    return EC_SUCCESS;
+}
+
+static int CopyParameter(const std::string &res, const char *def, char *value, unsigned int len)
+{
     if (res == "") {
-        if (!IsValidValue(def, len)) {
-            return EC_INVALID;
-        }
-        if (sprintf_s(value, len, "%s", def) < 0) {
-            return EC_FAILURE;
-        }
-        return EC_SUCCESS;
+        return CopyDefault(def, value, len);
     }
 
     const char *result = res.c_str();
@@ -77,10 +85,88 @@ int HalGetParameter(const char *key, const char *def, char *value, unsigned int
     return EC_SUCCESS;
 }
 
+// The well-known keys are const parameters, their node never moves once found and its handle is kept
+static bool FindKeyHandle(unsigned int id, unsigned int &handle)
+{
+    unsigned int cached = g_keyHandles[id].load(std::memory_order_relaxed);
+    if (cached != 0) {
+        handle = cached - 1;
+        return true;
+    }
+    if (SystemFindParameter(PARAM_KEY_NAMES[id], &handle) != 0) {
+        return false;
+    }
+    g_keyHandles[id].store(handle + 1, std::memory_order_relaxed);
+    return true;
+}
+
+// Read straight into the caller's buffer, no key validation, no name lookup and no string on the heap
+static int GetParameterByKeyId(unsigned int id, const char *def, char *value, unsigned int len)
+{
+    unsigned int handle = 0;
+    if (!FindKeyHandle(id, handle)) {
+        return CopyDefault(def, value, len);
+    }
+    unsigned int valueLen = len;
+    if ((SystemGetParameterValue(handle, value, &valueLen) == 0) && (value[0] != '\0')) {
+        return EC_SUCCESS;
+    }
+    // Tell a value too long for the buffer from an empty one, as the string-keyed path does
+    valueLen = 0;
+    if ((SystemGetParameterValue(handle, nullptr, &valueLen) == 0) && (valueLen > len)) {
+        return EC_INVALID;
+    }
+    return CopyDefault(def, value, len);
+}
+
+int HalGetParameter(const char *key, const char *def, char *value, unsigned int len)
+{
+    if ((key == nullptr) || (value == nullptr)) {
+        return EC_INVALID;
+    }
+    int id = ParamKeyLookup(key);
+    if (id >= 0) {
+        return GetParameterByKeyId(static_cast<unsigned int>(id), def, value, len);
+    }
+    int ret = OHOS::system::GetParameter(key, value, len);
+    if (ret > 0) {
+        return EC_SUCCESS;
+    }
+    return (ret == 0) ? CopyDefault(def, value, len) : EC_INVALID;
+}
+
+int HalGetParameters(ParameterItem *items, unsigned int count)
+{
+    if ((items == nullptr) || (count == 0)) {
+        return EC_INVALID;
+    }
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (unsigned int i = 0; i < count; i++) {
+        keys.emplace_back((items[i].key == nullptr) ? "" : items[i].key);
+    }
+    std::vector<std::string> values = OHOS::system::GetParameters(keys, "");
+    for (unsigned int i = 0; i < count; i++) {
+        if ((items[i].key == nullptr) || (items[i].value == nullptr)) {
+            items[i].ret = EC_INVALID;
+            continue;
+        }
+        items[i].ret = CopyParameter(values[i], items[i].def, items[i].value, items[i].len);
+    }
+    return EC_SUCCESS;
+}
+
+int HalGetParameterById(unsigned int id, const char *def, char *value, unsigned int len)
+{
+    if ((id >= PARAM_KEY_COUNT) || (value == nullptr)) {
+        return EC_INVALID;
+    }
+    return GetParameterByKeyId(id, def, value, len);
+}
+
 int HalGetIntParameter(const char *key, int def)
 {
-    const std::string strKey(key);
-    return OHOS::system::GetIntParameter(strKey, def);
+    return OHOS::system::GetIntParameter(key, def);
 }
 
 int HalSetParameter(const char *key, const char *value)
@@ -88,81 +174,125 @@ int HalSetParameter(const char *key, const char *value)
     if ((key == nullptr) || (value == nullptr)) {
         return EC_INVALID;
     }
-    const std::string strKey(key);
-    const std::string strVal(value);
-    bool ret = OHOS::system::SetParameter(strKey, strVal);
+    bool ret = OHOS::system::SetParameter(key, value);
     return ret ? EC_SUCCESS : EC_FAILURE;
 }
 
-const char *GetProperty(const std::string &key, const char **paramHolder)
+int HalSetParameters(const char *keys[], const char *values[], unsigned int count)
 {
-    if (paramHolder == nullptr) {
+    if ((keys == nullptr) || (values == nullptr) || (count == 0)) {
+        return EC_INVALID;
+    }
+    std::vector<std::string> strKeys;
+    std::vector<std::string> strValues;
+    strKeys.reserve(count);
+    strValues.reserve(count);
+    for (unsigned int i = 0; i < count; i++) {
+        if ((keys[i] == nullptr) || (values[i] == nullptr)) {
+            return EC_INVALID;
+        }
+        strKeys.emplace_back(keys[i]);
+        strValues.emplace_back(values[i]);
+    }
+    bool ret = OHOS::system::SetParameters(strKeys, strValues);
+    return ret ? EC_SUCCESS : EC_FAILURE;
+}
+
+namespace {
+// Every well-known field of the device, fetched in one batch and never changed nor freed once published
+struct DeviceInfoSnapshot {
+    const char *values[PARAM_KEY_COUNT]; // by ParamKeyId, pointing into the same allocation
+};
+
+std::atomic<const DeviceInfoSnapshot *> g_deviceInfo { nullptr };
+
+const DeviceInfoSnapshot *LoadDeviceInfo()
+{
+    std::vector<std::string> keys(PARAM_KEY_NAMES, PARAM_KEY_NAMES + PARAM_KEY_COUNT);
+    std::vector<std::string> values = OHOS::system::GetParameters(keys, "");
+    size_t size = sizeof(DeviceInfoSnapshot);
+    for (const auto &value : values) {
+        size += value.size() + 1;
+    }
+    char *buffer = static_cast<char *>(malloc(size));
+    if (buffer == nullptr) {
         return nullptr;
     }
-    if (*paramHolder != nullptr) {
-        return *paramHolder;
+    DeviceInfoSnapshot *snapshot = reinterpret_cast<DeviceInfoSnapshot *>(buffer);
+    char *strings = buffer + sizeof(DeviceInfoSnapshot);
+    for (unsigned int i = 0; i < PARAM_KEY_COUNT; i++) {
+        if (memcpy_s(strings, buffer + size - strings, values[i].c_str(), values[i].size() + 1) != 0) {
+            free(buffer);
+            return nullptr;
+        }
+        snapshot->values[i] = strings;
+        strings += values[i].size() + 1;
     }
-    std::string result = OHOS::system::GetParameter(key, "");
-    const char *res = strdup(result.c_str());
-    if (res == nullptr) {
-        return g_emptyStr;
+    return snapshot;
+}
+
+// Threads racing on the first call each load a snapshot, a single one is published and the others dropped
+const char *GetDeviceInfo(ParamKeyId id)
+{
+    const DeviceInfoSnapshot *snapshot = g_deviceInfo.load(std::memory_order_acquire);
+    if (snapshot == nullptr) {
+        const DeviceInfoSnapshot *loaded = LoadDeviceInfo();
+        if (loaded == nullptr) {
+            return g_emptyStr;
+        }
+        if (g_deviceInfo.compare_exchange_strong(snapshot, loaded, std::memory_order_acq_rel)) {
+            snapshot = loaded;
+        } else {
+            free(const_cast<DeviceInfoSnapshot *>(loaded));
+        }
     }
-    *paramHolder = res;
-    return *paramHolder;
+    return snapshot->values[id];
 }
+} // namespace
 
 const char *HalGetDeviceType()
 {
-    static const char *productType = nullptr;
-    return GetProperty("const.build.characteristics", &productType);
+    return GetDeviceInfo(PARAM_KEY_CONST_BUILD_CHARACTERISTICS);
 }
 
 const char *HalGetProductModel()
 {
-    static const char *productModel = nullptr;
-    return GetProperty("const.product.model", &productModel);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_MODEL);
 }
 
 const char *HalGetManufacture()
 {
-    static const char *productManufacture = nullptr;
-    return GetProperty("const.product.manufacturer", &productManufacture);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_MANUFACTURER);
 }
 
 const char *HalGetBrand()
 {
-    static const char *productBrand = nullptr;
-    return GetProperty("const.product.brand", &productBrand);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BRAND);
 }
 
 const char *HalGetMarketName()
 {
-    static const char *marketName = nullptr;
-    return GetProperty("const.product.name", &marketName);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_NAME);
 }
 
 const char *HalGetProductSeries()
 {
-    static const char *productSeries = nullptr;
-    return GetProperty("const.build.product", &productSeries);
+    return GetDeviceInfo(PARAM_KEY_CONST_BUILD_PRODUCT);
 }
 
 const char *HalGetSoftwareModel()
 {
-    static const char *softwareModel = nullptr;
-    return GetProperty("const.software.model", &softwareModel);
+    return GetDeviceInfo(PARAM_KEY_CONST_SOFTWARE_MODEL);
 }
 
 const char *HalGetHardwareModel()
 {
-    static const char *hardwareModel = nullptr;
-    return GetProperty("const.product.hardwareversion", &hardwareModel);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_HARDWAREVERSION);
 }
 
 const char *HalGetHardwareProfile()
 {
-    static const char *hardwareProfile = nullptr;
-    return GetProperty("const.product.hardwareprofile", &hardwareProfile);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_HARDWAREPROFILE);
 }
 
 const char *HalGetSerial()
@@ -190,91 +320,77 @@ const char *HalGetSerial()
 
 const char *HalGetAbiList()
 {
-    static const char *productAbiList = nullptr;
-    return GetProperty("const.product.cpu.abilist", &productAbiList);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_CPU_ABILIST);
 }
 
 const char *HalGetBootloaderVersion()
 {
-    static const char *productBootloader = nullptr;
-    return GetProperty("const.product.bootloader.version", &productBootloader);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BOOTLOADER_VERSION);
 }
 
 const char *HalGetSecurityPatchTag()
 {
-    static const char *securityPatchTag = nullptr;
-    return GetProperty("const.ohos.version.security_patch", &securityPatchTag);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_VERSION_SECURITY_PATCH);
 }
 
 int HalGetFirstApiVersion()
 {
-    static const char *firstApiVersion = nullptr;
-    return atoi(GetProperty("const.product.firstapiversion", &firstApiVersion));
+    return atoi(GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_FIRSTAPIVERSION));
 }
 
 const char *HalGetDisplayVersion()
 {
-    static const char *displayVersion = nullptr;
-    return GetProperty("const.product.software.version", &displayVersion);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_SOFTWARE_VERSION);
 }
 
 const char *HalGetIncrementalVersion()
 {
-    static const char *incrementalVersion = nullptr;
-    return GetProperty("const.product.incremental.version", &incrementalVersion);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_INCREMENTAL_VERSION);
 }
 
 const char *HalGetOsReleaseType()
 {
-    static const char *osReleaseType = nullptr;
-    return GetProperty("const.ohos.releasetype", &osReleaseType);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_RELEASETYPE);
 }
 
 const char *HalGetSdkApiVersion()
 {
-    static const char *sdkApiVersion = nullptr;
-    return GetProperty("const.ohos.apiversion", &sdkApiVersion);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_APIVERSION);
 }
+
 const char *HalGetBuildRootHash()
 {
-    static const char *buildRootHash = nullptr;
-    return GetProperty("const.ohos.buildroothash", &buildRootHash);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_BUILDROOTHASH);
 }
 
 const char *HalGetSdkApiLevel()
 {
-    static const char *sdkApiLevel = nullptr;
-    return GetProperty("const.ohos.sdkapilevel", &sdkApiLevel);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_SDKAPILEVEL);
 }
 
 const char *HalGetOSName()
 {
-    static const char *osName = nullptr;
-    return GetProperty("const.ohos.name", &osName);
+    return GetDeviceInfo(PARAM_KEY_CONST_OHOS_NAME);
 }
 
 const char *HalGetBuildType()
 {
-    static const char *buildType = nullptr;
-    return GetProperty("const.product.build.type", &buildType);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BUILD_TYPE);
 }
 
 const char *HalGetBuildUser()
 {
-    static const char *buildUser = nullptr;
-    return GetProperty("const.product.build.user", &buildUser);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BUILD_USER);
 }
 
 const char *HalGetBuildHost()
 {
-    static const char *buildHost = nullptr;
-    return GetProperty("const.product.build.host", &buildHost);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BUILD_HOST);
 }
 
 const char *HalGetBuildTime()
 {
-    static const char *buildTime = nullptr;
-    return GetProperty("const.product.build.date", &buildTime);
+    return GetDeviceInfo(PARAM_KEY_CONST_PRODUCT_BUILD_DATE);
 }
 
 int HalWaitParameter(const char *key, const char *value, int timeout)
@@ -285,6 +401,63 @@ int HalWaitParameter(const char *key, const char *value, int timeout)
     return OHOS::system::WaitParameter(key, value, timeout);
 }
 
+int HalForEachParameter(const char *prefix, ParameterVisitor visitor, void *context)
+{
+    if ((prefix == nullptr) || (visitor == nullptr)) {
+        return EC_INVALID;
+    }
+    return OHOS::system::ForEachParameter(prefix, [visitor, context](const char *key, const char *value) {
+        return visitor(key, value, context) == 0;
+    });
+}
+
+namespace {
+struct ParameterSequence {
+    const char *prefix;
+    size_t prefixLen;
+    unsigned long long sum;
+};
+
+// Each commit id counts one more, so a parameter added under the prefix moves the sum on as well
+void AddCommitId(ParamHandle handle, void *cookie)
+{
+    ParameterSequence *sequence = static_cast<ParameterSequence *>(cookie);
+    char name[PARAM_NAME_LEN_MAX] = { 0 };
+    unsigned int commitId = 0;
+    if ((SystemGetParameterName(handle, name, sizeof(name)) != 0) ||
+        (strncmp(name, sequence->prefix, sequence->prefixLen) != 0) ||
+        (SystemGetParameterCommitId(handle, &commitId) != 0)) {
+        return;
+    }
+    sequence->sum += commitId + 1ULL;
+}
+} // namespace
+
+/*
+ * Writes reach the parameter service from many clients besides this one, so the sequence is derived
+ * from the commit ids the service keeps: one lookup for a key, a pass over the workspace for a prefix.
+ */
+long long HalGetParameterSequence(const char *prefix)
+{
+    if (prefix == nullptr) {
+        return EC_INVALID;
+    }
+    size_t prefixLen = strlen(prefix);
+    if ((prefixLen > 0) && (prefix[prefixLen - 1] != '.')) {
+        unsigned int handle = 0;
+        unsigned int commitId = 0;
+        if ((SystemFindParameter(prefix, &handle) != 0) || (SystemGetParameterCommitId(handle, &commitId) != 0)) {
+            return 0;
+        }
+        return commitId + 1LL;
+    }
+    ParameterSequence sequence = { prefix, prefixLen, 0 };
+    if (SystemTraversalParameter(AddCommitId, &sequence) != 0) {
+        return EC_FAILURE;
+    }
+    return static_cast<long long>(sequence.sum);
+}
+
 unsigned int HalFindParameter(const char *key)
 {
     if (key == nullptr) {
@@ -328,12 +501,12 @@ int HalGetParameterValue(unsigned int handle, char *value, unsigned int len)
     return strcpy_s(value, len, data.c_str());
 }
 
-static int HalGetSha256Value(const char *input, char *udid, int udidSize)
+// udid receives the upper case hex digest, it is DEV_UUID_LENGTH bytes long
+static int HalGetSha256Value(const char *input, char *udid)
 {
     if (input == nullptr || udid == nullptr) {
         return EC_FAILURE;
     }
-    char buf[DEV_BUF_LENGTH] = { 0 };
     unsigned char hash[SHA256_DIGEST_LENGTH] = { 0 };
     SHA256_CTX sha256;
     if ((SHA256_Init(&sha256) == 0) || (SHA256_Update(&sha256, input, strlen(input)) == 0) ||
@@ -342,22 +515,15 @@ static int HalGetSha256Value(const char *input, char *udid, int udidSize)
     }
 
     for (size_t i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-        unsigned char value = hash[i];
-        (void)memset_s(buf, DEV_BUF_LENGTH, 0, DEV_BUF_LENGTH);
-        (void)sprintf_s(buf, sizeof(buf), "%02X", value);
-        if (strcat_s(udid, udidSize, buf) != 0) {
-            return EC_FAILURE;
-        }
+        udid[i * 2] = HEX_DIGITS[hash[i] >> HEX_HIGH_SHIFT]; // 2: hex digits per byte
+        udid[i * 2 + 1] = HEX_DIGITS[hash[i] & HEX_LOW_MASK]; // 2: hex digits per byte
     }
+    udid[SHA256_DIGEST_LENGTH * 2] = '\0'; // 2: hex digits per byte
     return EC_SUCCESS;
 }
 
-int HalGetDevUdid(char *udid, int size)
+static int ComputeDevUdid(char *udid)
 {
-    if (size < DEV_UUID_LENGTH) {
-        return EC_INVALID;
-    }
-
     const char *manufacture = HalGetManufacture();
     const char *model = HalGetProductModel();
     const char *sn = HalGetSerial();
@@ -380,7 +546,32 @@ int HalGetDevUdid(char *udid, int size)
         return EC_SYSTEM_ERR;
     }
 
-    int ret = HalGetSha256Value(tmp, udid, size);
+    int ret = HalGetSha256Value(tmp, udid);
     free(tmp);
     return ret;
 }
+
+namespace {
+// The udid only depends on const parameters and the serial, it is computed once per process
+std::mutex g_devUdidMutex;
+char g_devUdid[DEV_UUID_LENGTH] = { 0 };
+std::atomic<bool> g_devUdidReady { false };
+} // namespace
+
+int HalGetDevUdid(char *udid, int size)
+{
+    if ((udid == nullptr) || (size < DEV_UUID_LENGTH)) {
+        return EC_INVALID;
+    }
+    if (!g_devUdidReady.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(g_devUdidMutex);
+        if (!g_devUdidReady.load(std::memory_order_relaxed)) {
+            int ret = ComputeDevUdid(g_devUdid);
+            if (ret != EC_SUCCESS) {
+                return ret;
+            }
+            g_devUdidReady.store(true, std::memory_order_release);
+        }
+    }
+    return (memcpy_s(udid, size, g_devUdid, DEV_UUID_LENGTH) == 0) ? EC_SUCCESS : EC_FAILURE;
+}
@@ -59,6 +59,76 @@ int GetParameter(const char *key, const char *def, char *value, unsigned int len
  */
 int SetParameter(const char *key, const char *value);
 
+/**
+ * @brief Describes one system parameter of a batch read.
+ *
+ * @since 1
+ * @version 1
+ */
+typedef struct {
+    /** Key of the system parameter to query, same restrictions as for {@link GetParameter} */
+    const char *key;
+    /** Default value to return when no query result is found, can be <b>NULL</b> */
+    const char *def;
+    /** Data buffer that stores the query result, applied for and released by the caller */
+    char *value;
+    /** Length of the data buffer */
+    unsigned int len;
+    /** Result of this key, set to what {@link GetParameter} would have returned for it */
+    int ret;
+} ParameterItem;
+
+/**
+ * @brief Obtains several system parameters in one pass.
+ *
+ * Each item is resolved exactly like {@link GetParameter} and its result is stored in <b>ret</b> of the item,
+ * so that one missing or invalid key does not fail the others.\n
+ *
+ * @param items Indicates the array of parameters to query.
+ * @param count Indicates the number of items in the array.
+ * @return Returns the number of items whose <b>ret</b> is not negative;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1
+ * @version 1
+ */
+int GetParameters(ParameterItem *items, unsigned int count);
+
+/**
+ * @brief Obtains a well-known system parameter by its identifier.
+ *
+ * Same as {@link GetParameter} for the key of <b>id</b>, without looking the key up by name.
+ * The identifiers are the <b>ParamKeyId</b> values of param_key_ids.h, generated at build time from the
+ * manifest of the well-known keys.\n
+ *
+ * @param id Indicates the identifier of the system parameter to query.
+ * @param def Indicates the default value to return when no query result is found, can be <b>NULL</b>.
+ * @param value Indicates the data buffer that stores the query result.
+ * @param len Indicates the length of the data in the buffer.
+ * @return Returns the number of bytes of the system parameter if the operation is successful;
+ * returns <b>-9</b> if the identifier or another parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1
+ * @version 1
+ */
+int GetParameterById(unsigned int id, const char *def, char *value, unsigned int len);
+
+/**
+ * @brief Sets or updates several system parameters at once.
+ *
+ * The keys are handed to the parameter service one after the other, there is no transaction:
+ * a failure may leave the first keys set, and a concurrent {@link GetParameters} may observe
+ * part of the batch.\n
+ *
+ * @param keys Indicates the keys of the parameters to set, same restrictions as for {@link SetParameter}.
+ * @param values Indicates the values, <b>values[i]</b> being the value of <b>keys[i]</b>.
+ * @param count Indicates the number of keys.
+ * @return Returns <b>0</b> if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect;
+ * returns <b>-1</b> in other scenarios, possibly with some of the keys set.
+ * @since 1
+ * @version 1
+ */
+int SetParameters(const char *keys[], const char *values[], unsigned int count);
+
 /**
  * @brief Wait for a system parameter with specified value.
  *
@@ -97,8 +167,45 @@ int WaitParameter(const char *key, const char *value, int timeout);
 typedef void (*ParameterChgPtr)(const char *key, const char *value, void *context);
 int WatchParameter(const char *keyprefix, ParameterChgPtr callback, void *context);
 
+/**
+ * @brief Visits the system parameters whose key starts with a prefix.
+ *
+ * The values are read while the parameters are visited, a parameter set concurrently may be
+ * visited with its old or its new value.\n
+ * There is no index of the keys by prefix: every key of the store is compared with the prefix,
+ * so a visit costs as much as the number of parameters stored, however few of them match.
+ * It is meant for diagnostics, not for paths that run often.\n
+ *
+ * @param prefix Indicates the key prefix of the parameters to visit, "A.B." for example.
+ * An empty prefix visits every parameter.
+ * @param visitor Indicates the function called once for each parameter with its key and value.
+ * Returning a value other than <b>0</b> stops the visit.
+ * @param context Indicates the pointer passed to <b>visitor</b> as it is.
+ * @return Returns the number of parameters visited if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1
+ * @version 1
+ */
+typedef int (*ParameterVisitor)(const char *key, const char *value, void *context);
+int ForEachParameter(const char *prefix, ParameterVisitor visitor, void *context);
+
 long long GetSystemCommitId(void);
 
+/**
+ * @brief Obtains the change sequence number of system parameters.
+ *
+ * The sequence number moves on whenever a parameter it covers is stored, and may move on when other
+ * parameters are, so an unchanged sequence number means that none of them changed.\n
+ *
+ * @param prefix Indicates the parameters covered: the ones whose key starts with <b>prefix</b> when it
+ * ends with a dot, "A.B." for example, the parameter <b>prefix</b> otherwise, every parameter when it is empty.
+ * @return Returns the sequence number if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1
+ * @version 1
+ */
+long long GetParameterSequence(const char *prefix);
+
 const char *GetSecurityPatchTag(void);
 const char *GetOSFullName(void);
 const char *GetVersionId(void);
@@ -15,6 +15,7 @@
 
 #include "parameter.h"
 
+#include <pthread.h>
 #include <securec.h>
 #include <string.h>
 
@@ -27,7 +28,14 @@
 
 static const int DEV_UUID_LENGTH = 65;
 
-static const char EMPTY_STR[] = { "" };
+/*
+ * Properties composed from const parameters once, by the first caller, the others wait for it:
+ * the release type is only known at runtime.
+ */
+static char g_osFullName[OS_FULL_NAME_LEN] = {0};
+static pthread_once_t g_osFullNameOnce = PTHREAD_ONCE_INIT;
+static char g_versionId[VERSION_ID_MAX_LEN] = {0};
+static pthread_once_t g_versionIdOnce = PTHREAD_ONCE_INIT;
 
 int GetParameter(const char *key, const char *def, char *value, unsigned int len)
 {
@@ -38,6 +46,34 @@ int GetParameter(const char *key, const char *def, char *value, unsigned int len
     return (ret < 0) ? ret : strlen(value);
 }
 
+int GetParameters(ParameterItem *items, unsigned int count)
+{
+    if ((items == NULL) || (count == 0)) {
+        return EC_INVALID;
+    }
+    int ret = HalGetParameters(items, count);
+    if (ret < 0) {
+        return ret;
+    }
+    int found = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        if (items[i].ret >= 0) {
+            items[i].ret = strlen(items[i].value);
+            found++;
+        }
+    }
+    return found;
+}
+
+int GetParameterById(unsigned int id, const char *def, char *value, unsigned int len)
+{
+    if (value == NULL) {
+        return EC_INVALID;
+    }
+    int ret = HalGetParameterById(id, def, value, len);
+    return (ret < 0) ? ret : strlen(value);
+}
+
 int SetParameter(const char *key, const char *value)
 {
     if ((key == NULL) || (value == NULL)) {
@@ -46,6 +82,14 @@ int SetParameter(const char *key, const char *value)
     return HalSetParameter(key, value);
 }
 
+int SetParameters(const char *keys[], const char *values[], unsigned int count)
+{
+    if ((keys == NULL) || (values == NULL) || (count == 0)) {
+        return EC_INVALID;
+    }
+    return HalSetParameters(keys, values, count);
+}
+
 int WaitParameter(const char *key, const char *value, int timeout)
 {
     if ((key == NULL) || (value == NULL)) {
@@ -124,37 +168,29 @@ static const char *GetOSName(void)
     return HalGetOSName();
 }
 
-static const char *BuildOSFullName(void)
+static void BuildOSFullName(void)
 {
+    char *value = g_osFullName;
+    unsigned int len = sizeof(g_osFullName);
     const char release[] = "Release";
-    char value[OS_FULL_NAME_LEN] = {0};
     const char *releaseType = GetOsReleaseType();
     int length;
     if (strncmp(releaseType, release, sizeof(release) - 1) == 0) {
-        length = sprintf_s(value, OS_FULL_NAME_LEN, "%s-%d.%d.%d.%d",
+        length = sprintf_s(value, len, "%s-%d.%d.%d.%d",
             GetOSName(), GetMajorVersion(), GetSeniorVersion(), GetFeatureVersion(), GetBuildVersion());
     } else {
-        length = sprintf_s(value, OS_FULL_NAME_LEN, "%s-%d.%d.%d.%d(%s)",
+        length = sprintf_s(value, len, "%s-%d.%d.%d.%d(%s)",
             GetOSName(), GetMajorVersion(), GetSeniorVersion(), GetFeatureVersion(), GetBuildVersion(), releaseType);
     }
     if (length < 0) {
-        return EMPTY_STR;
+        value[0] = '\0';
     }
-    const char *osFullName = strdup(value);
-    return osFullName;
 }
 
 const char *GetOSFullName(void)
 {
-    static const char *osFullName = NULL;
-    if (osFullName != NULL) {
-        return osFullName;
-    }
-    osFullName = BuildOSFullName();
-    if (osFullName == NULL) {
-        return EMPTY_STR;
-    }
-    return osFullName;
+    (void)pthread_once(&g_osFullNameOnce, BuildOSFullName);
+    return g_osFullName;
 }
 
 int GetSdkApiVersion(void)
@@ -180,31 +216,21 @@ static int GetSdkApiLevel(void)
 {
     return atoi(HalGetSdkApiLevel());
 }
-static const char *BuildVersionId(void)
+static void BuildVersionId(void)
 {
-    char value[VERSION_ID_MAX_LEN] = {0};
-    int len = sprintf_s(value, VERSION_ID_MAX_LEN, "%s/%s/%s/%s/%s/%s/%s/%d/%s/%s",
+    int length = sprintf_s(g_versionId, sizeof(g_versionId), "%s/%s/%s/%s/%s/%s/%s/%d/%s/%s",
         GetDeviceType(), GetManufacture(), GetBrand(), GetProductSeries(),
         GetOSFullName(), GetProductModel(), GetSoftwareModel(),
         GetSdkApiLevel(), GetIncrementalVersion(), GetBuildType());
-    if (len < 0) {
-        return EMPTY_STR;
+    if (length < 0) {
+        g_versionId[0] = '\0';
     }
-    const char *versionId = strdup(value);
-    return versionId;
 }
 
 const char *GetVersionId(void)
 {
-    static const char *ohosVersionId = NULL;
-    if (ohosVersionId != NULL) {
-        return ohosVersionId;
-    }
-    ohosVersionId = BuildVersionId();
-    if (ohosVersionId == NULL) {
-        return EMPTY_STR;
-    }
-    return ohosVersionId;
+    (void)pthread_once(&g_versionIdOnce, BuildVersionId);
+    return g_versionId;
 }
 
 const char *GetBuildType(void)
@@ -245,6 +271,22 @@ int GetDevUdid(char *udid, int size)
     return HalGetDevUdid(udid, size);
 }
 
+int ForEachParameter(const char *prefix, ParameterVisitor visitor, void *context)
+{
+    if ((prefix == NULL) || (visitor == NULL)) {
+        return EC_INVALID;
+    }
+    return HalForEachParameter(prefix, visitor, context);
+}
+
+long long GetParameterSequence(const char *prefix)
+{
+    if (prefix == NULL) {
+        return EC_INVALID;
+    }
+    return HalGetParameterSequence(prefix);
+}
+
 unsigned int FindParameter(const char *name)
 {
     if (name == NULL) {
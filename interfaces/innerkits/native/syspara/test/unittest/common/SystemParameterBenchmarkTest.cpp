@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "parameter.h"
+#include "parameters.h"
+#include "sys_param.h"
+
+using namespace testing::ext;
+
+namespace {
+std::atomic<long long> g_allocations(0);
+}
+
+/* Counts every allocation of the test binary, the benchmark reads the difference around its loops */
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = malloc((size == 0) ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace OHOS {
+namespace {
+const int BENCH_READS = 20000;
+const char BENCH_KEY[] = "test.rw.sys.version.bench";
+const char BENCH_VALUE[] = "a value longer than what a string keeps inline";
+
+/* GetParameter as it was: probe the length, read into a vector, then copy into the string */
+std::string ProbeThenReadGet(const std::string& key, const std::string& def)
+{
+    unsigned int len = 0;
+    int ret = SystemGetParameter(key.c_str(), nullptr, &len);
+    if (ret == 0 && len > 0) {
+        std::vector<char> value(len + 1);
+        ret = SystemGetParameter(key.c_str(), value.data(), &len);
+        if (ret == 0) {
+            return std::string(value.data());
+        }
+    }
+    return def;
+}
+
+struct BenchResult {
+    long long nanosPerRead;
+    double allocationsPerRead;
+};
+
+template<typename Read>
+BenchResult Bench(Read read)
+{
+    long long allocations = g_allocations.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_READS; i++) {
+        read();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    allocations = g_allocations.load(std::memory_order_relaxed) - allocations;
+    return { std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / BENCH_READS,
+        static_cast<double>(allocations) / BENCH_READS };
+}
+
+/* A few of the string properties of the JS deviceInfo module, with the getters behind them */
+struct DeviceInfoString {
+    const char *name;
+    const char *(*getter)(void);
+};
+
+const DeviceInfoString DEVICE_INFO_STRINGS[] = {
+    { "brand", GetBrand },
+    { "productModel", GetProductModel },
+    { "osFullName", GetOSFullName },
+    { "versionId", GetVersionId },
+};
+
+void Report(const char *name, const BenchResult& result)
+{
+    printf("%-16s %6lld ns per read, %.2f allocations per read\n", name, result.nanosPerRead,
+        result.allocationsPerRead);
+}
+}  // namespace
+
+class SystemParameterBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/*
+ * The same key read through one bare lookup, the former probe then read pattern, and GetParameter.
+ * GetParameter should cost about one lookup, and allocate the returned string only.
+ */
+HWTEST_F(SystemParameterBenchmarkTest, parameterBenchmark001, TestSize.Level3)
+{
+    ASSERT_TRUE(system::SetParameter(BENCH_KEY, BENCH_VALUE));
+    const std::string key(BENCH_KEY);
+    ASSERT_EQ(system::GetParameter(key, ""), BENCH_VALUE);
+    ASSERT_EQ(ProbeThenReadGet(key, ""), BENCH_VALUE);
+
+    BenchResult lookup = Bench([]() {
+        char value[PARAM_VALUE_LEN_MAX] = {0};
+        unsigned int len = sizeof(value);
+        (void)SystemGetParameter(BENCH_KEY, value, &len);
+    });
+    BenchResult probeThenRead = Bench([&key]() {
+        (void)ProbeThenReadGet(key, "");
+    });
+    BenchResult getParameter = Bench([&key]() {
+        (void)system::GetParameter(key, "");
+    });
+    Report("one lookup", lookup);
+    Report("probe then read", probeThenRead);
+    Report("GetParameter", getParameter);
+    EXPECT_LT(getParameter.allocationsPerRead, probeThenRead.allocationsPerRead);
+    EXPECT_LE(getParameter.allocationsPerRead, 1.0);
+}
+
+/*
+ * The native work of one access of a deviceInfo string property before the module kept its JS
+ * string: the getter and the strlen of the value. GetCachedString skips both after the first
+ * access, the property reads themselves are timed by DeviceInfoBenchmarkTest in the JS unittest
+ * of the module. Caching is only right as long as the getters return the same value on every call.
+ */
+HWTEST_F(SystemParameterBenchmarkTest, parameterBenchmark002, TestSize.Level3)
+{
+    for (const auto& property : DEVICE_INFO_STRINGS) {
+        const char *first = property.getter();
+        ASSERT_NE(first, nullptr);
+        const std::string value(first);
+        size_t length = 0;
+        BenchResult uncached = Bench([&property, &length]() {
+            const char *current = property.getter();
+            length += (current != nullptr) ? strlen(current) : 0;
+        });
+        EXPECT_EQ(length, value.size() * BENCH_READS);
+        EXPECT_EQ(value, property.getter());
+        Report(property.name, uncached);
+    }
+}
+}  // namespace OHOS
@@ -15,6 +15,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cstring>
+#include "cached_parameter.h"
+#include "param_key_ids.h"
 #include "parameter.h"
 #include "sysparam_errno.h"
 
@@ -214,4 +217,151 @@ HWTEST_F(SystemParameterNativeTest, parameterTest0012, TestSize.Level0)
     ret = GetParameterName(handle, nameGet1, 32);
     EXPECT_EQ(ret, -1);
 }
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0013, TestSize.Level0)
+{
+    char key1[] = "test.rw.sys.version.batch1";
+    int ret = SetParameter(key1, "10.1.0");
+    EXPECT_EQ(ret, 0);
+
+    char valueGet1[32] = {0};
+    char valueGet2[32] = {0};
+    char valueGet3[32] = {0};
+    char defValue2[] = "value of key not exist...";
+    ParameterItem items[] = {
+        { key1, nullptr, valueGet1, sizeof(valueGet1), 0 },
+        { "test.rw.sys.version.batch2", defValue2, valueGet2, sizeof(valueGet2), 0 },
+        { nullptr, nullptr, valueGet3, sizeof(valueGet3), 0 },
+    };
+    ret = GetParameters(items, sizeof(items) / sizeof(items[0]));
+    EXPECT_EQ(ret, 2);
+    EXPECT_STREQ(valueGet1, "10.1.0");
+    EXPECT_EQ(items[0].ret, static_cast<int>(strlen(valueGet1)));
+    EXPECT_STREQ(valueGet2, defValue2);
+    EXPECT_EQ(items[1].ret, static_cast<int>(strlen(defValue2)));
+    EXPECT_EQ(items[2].ret, EC_INVALID);
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0014, TestSize.Level0)
+{
+    const char *keys[] = { "test.rw.sys.version.batch3", "test.rw.sys.version.batch4" };
+    const char *values[] = { "10.1.0", "10.1.1" };
+    int ret = SetParameters(keys, values, 2);
+    EXPECT_EQ(ret, 0);
+    char valueGet1[32] = {0};
+    ret = GetParameter(keys[0], "", valueGet1, 32);
+    EXPECT_STREQ(valueGet1, values[0]);
+    char valueGet2[32] = {0};
+    ret = GetParameter(keys[1], "", valueGet2, 32);
+    EXPECT_STREQ(valueGet2, values[1]);
+
+    ret = SetParameters(nullptr, values, 2);
+    EXPECT_EQ(ret, EC_INVALID);
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0015, TestSize.Level0)
+{
+    char valueById[128] = {0};
+    char valueByKey[128] = {0};
+    int ret = GetParameterById(PARAM_KEY_CONST_PRODUCT_MODEL, "default", valueById, sizeof(valueById));
+    EXPECT_GT(ret, 0);
+    EXPECT_EQ(ret, GetParameter("const.product.model", "default", valueByKey, sizeof(valueByKey)));
+    EXPECT_STREQ(valueById, valueByKey);
+    EXPECT_STREQ(valueById, GetProductModel());
+
+    ret = GetParameterById(PARAM_KEY_COUNT, "default", valueById, sizeof(valueById));
+    EXPECT_EQ(ret, EC_INVALID);
+    ret = GetParameterById(PARAM_KEY_CONST_PRODUCT_MODEL, "default", nullptr, sizeof(valueById));
+    EXPECT_EQ(ret, EC_INVALID);
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0016, TestSize.Level0)
+{
+    system::CachedParameter<int32_t> cached("test.rw.sys.version.cached1", -1);
+    EXPECT_EQ(cached.Get(), -1);
+    EXPECT_TRUE(system::SetParameter("test.rw.sys.version.cached1", "10"));
+    EXPECT_EQ(cached.Get(), 10);
+    EXPECT_EQ(cached.Get(), 10);
+    EXPECT_TRUE(system::SetParameter("test.rw.sys.version.cached1", "0x20"));
+    EXPECT_EQ(cached.Get(), 32);
+    EXPECT_TRUE(system::SetParameter("test.rw.sys.version.cached1", "not a number"));
+    EXPECT_EQ(cached.Get(), -1);
+
+    system::CachedParameter<std::string> cachedString("test.rw.sys.version.cached1", "default");
+    EXPECT_EQ(cachedString.Get(), "not a number");
+    system::CachedParameter<bool> cachedBool("test.rw.sys.version.cached2", true);
+    EXPECT_TRUE(system::SetParameter("test.rw.sys.version.cached2", "off"));
+    EXPECT_FALSE(cachedBool.Get());
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0017, TestSize.Level0)
+{
+    const char *key = "test.rw.sys.version.overload1";
+    EXPECT_TRUE(system::SetParameter(key, "25"));
+    EXPECT_EQ(system::GetParameter(key, "default"), "25");
+    EXPECT_EQ(system::GetIntParameter(key, 0), 25);
+    EXPECT_EQ(system::GetUintParameter<uint8_t>(key, 0), 25);
+    EXPECT_FALSE(system::GetBoolParameter(key, false));
+    EXPECT_NE(system::FindParameter(key), static_cast<unsigned int>(-1));
+
+    char value[3] = {0};
+    EXPECT_EQ(system::GetParameter(key, value, sizeof(value)), 2);
+    EXPECT_STREQ(value, "25");
+    EXPECT_EQ(system::GetParameter(key, value, 2), -1);
+    EXPECT_EQ(system::GetParameter("test.rw.sys.version.overload2", value, sizeof(value)), 0);
+    EXPECT_EQ(system::GetParameter("test.rw.sys.version.overload2", "default"), "default");
+    EXPECT_EQ(system::GetParameter(nullptr, value, sizeof(value)), -1);
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0018, TestSize.Level0)
+{
+    const char *key = "test.rw.sys.version.typed1";
+    EXPECT_TRUE(system::SetParameter(key, "-0x20"));
+    EXPECT_EQ(system::GetIntParameter(key, 0), -32);
+    EXPECT_EQ(system::GetUintParameter<uint32_t>(key, 7), 7u);
+    EXPECT_TRUE(system::SetParameter(key, "2.5"));
+    EXPECT_DOUBLE_EQ(system::GetDoubleParameter(key, 0.0), 2.5);
+    EXPECT_EQ(system::GetIntParameter(key, 0), 0);
+
+    EXPECT_TRUE(system::SetParameter(key, "1500ms"));
+    EXPECT_EQ(system::GetDurationParameter(key), std::chrono::milliseconds(1500));
+    EXPECT_TRUE(system::SetParameter(key, "3s"));
+    EXPECT_EQ(system::GetDurationParameter(key), std::chrono::milliseconds(3000));
+    EXPECT_FALSE(system::GetSizeParameter(key).has_value());
+    EXPECT_TRUE(system::SetParameter(key, "64K"));
+    EXPECT_EQ(system::GetSizeParameter(key), 64u * 1024u);
+    EXPECT_FALSE(system::GetDurationParameter(key).has_value());
+    EXPECT_FALSE(system::GetDurationParameter("test.rw.sys.version.typed2").has_value());
+}
+
+static int CountVisited(const char *key, const char *value, void *context)
+{
+    if ((strncmp(key, "test.rw.each.", strlen("test.rw.each.")) == 0) && (strcmp(value, "1") == 0)) {
+        (*static_cast<int *>(context))++;
+    }
+    return 0;
+}
+
+HWTEST_F(SystemParameterNativeTest, parameterTest0019, TestSize.Level0)
+{
+    int visited = 0;
+    EXPECT_EQ(ForEachParameter(nullptr, CountVisited, &visited), EC_INVALID);
+    EXPECT_EQ(ForEachParameter("test.rw.each.", nullptr, &visited), EC_INVALID);
+
+    EXPECT_EQ(SetParameter("test.rw.each.first", "1"), 0);
+    EXPECT_EQ(SetParameter("test.rw.each.second", "1"), 0);
+    EXPECT_EQ(SetParameter("test.rw.other", "1"), 0);
+    EXPECT_EQ(ForEachParameter("test.rw.each.", CountVisited, &visited), 2);
+    EXPECT_EQ(visited, 2);
+
+    int stopped = 0;
+    EXPECT_EQ(system::ForEachParameter("test.rw.", [&stopped](const char *, const char *) {
+        stopped++;
+        return false;
+    }), 1);
+    EXPECT_EQ(stopped, 1);
+    EXPECT_EQ(system::ForEachParameter("test.rw.none.", [](const char *, const char *) {
+        return true;
+    }), 0);
+}
 }  // namespace OHOS
@@ -98,7 +98,7 @@ declare namespace systemParameter {
      * @param key Key of the system parameter.
      * @param value System parameter value to be wait.
      * @param timeout Indicates the timeout value, in seconds.
-     * <=0 means wait for ever.
+     * <=0 means the default timeout of 30 seconds.
      * >0 means wait for specified seconds
      * @param callback Callback function.
      * @since 7
@@ -111,7 +111,7 @@ declare namespace systemParameter {
       * @param key Key of the system parameter.
       * @param value System parameter value to be wait.
       * @param timeout Indicates the timeout value, in seconds.
-      * <=0 means wait for ever.
+      * <=0 means the default timeout of 30 seconds.
       * >0 means wait for specified seconds
       * @return Promise, which is used to obtain the result asynchronously.
       * @since 7
@@ -122,10 +122,11 @@ declare namespace systemParameter {
       * Wait for a parameter with specified value.
       *
       * @param keyPrefix Key prefix of the system parameters to be watched.
-      * @param callback Callback function.
+      * @param coalesce Whether only the latest value of each changed key is delivered per event loop turn.
+      * Defaults to false, every change is delivered then.
       * @since 7
       */
-     function getWatcher(keyPrefix: string): Watcher;
+     function getWatcher(keyPrefix: string, coalesce?: boolean): Watcher;
 
      /**
       * Called when the system parameter value changes. You need to implement this method in a child class.
@@ -14,7 +14,10 @@
  */
 
 #include <cstdio>
+#include <cstring>
+#include <new>
 #include <string>
+#include <vector>
 
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
@@ -23,157 +26,90 @@
 
 const int UDID_LEN = 65;
 
-static napi_value GetDeviceType(napi_env env, napi_callback_info info)
-{
-    napi_value deviceType = nullptr;
-    const char *value = GetDeviceType();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, value, strlen(value), &deviceType));
-    return deviceType;
-}
-
-static napi_value GetManufacture(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *manfactureName = GetManufacture();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, manfactureName, strlen(manfactureName), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBrand(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *productBrand = GetBrand();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, productBrand, strlen(productBrand), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetMarketName(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *marketName = GetMarketName();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, marketName, strlen(marketName), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetProductSeries(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *productSeries = GetProductSeries();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, productSeries, strlen(productSeries), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetProductModel(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *productModel = GetProductModel();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, productModel, strlen(productModel), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetSoftwareModel(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *softwareModel = GetSoftwareModel();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, softwareModel, strlen(softwareModel), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetHardwareModel(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *hardwareModel = GetHardwareModel();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, hardwareModel, strlen(hardwareModel), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetHardwareProfile(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *hardwareProfile = GetHardwareProfile();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, hardwareProfile, strlen(hardwareProfile), &napiValue));
-    return napiValue;
-}
+// Returns nullptr when the value can't be obtained for now
+using StringGetter = const char *(*)(void);
 
-static napi_value GetSerial(napi_env env, napi_callback_info info)
+// Hashes the serial with the manufacturer and the model, far too costly to run before the udid is read
+static const char *GetDevUdid(void)
 {
-    napi_value napiValue = nullptr;
-    const char *serialNumber = AclGetSerial();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, serialNumber, strlen(serialNumber), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBootloaderVersion(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *bootloaderVersion = GetBootloaderVersion();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, bootloaderVersion, strlen(bootloaderVersion), &napiValue));
-    return napiValue;
+    thread_local char localDeviceId[UDID_LEN] = {0};
+    return (AclGetDevUdid(localDeviceId, UDID_LEN) == 0) ? localDeviceId : nullptr;
 }
 
-static napi_value GetAbiList(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *abiList = GetAbiList();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, abiList, strlen(abiList), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetSecurityPatchTag(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *securityPatchTag = GetSecurityPatchTag();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, securityPatchTag, strlen(securityPatchTag), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetDisplayVersion(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *productVersion = GetDisplayVersion();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, productVersion, strlen(productVersion), &napiValue));
-    return napiValue;
-}
+/*
+ * The strings of the device info don't change while the process runs. Nothing is read when the
+ * module loads: each one is fetched on its first access in the env, the const parameters from the
+ * device info snapshot of the process, the serial and the udid by their own, slower, getters.
+ */
+using StringProperty = struct {
+    const char *name;
+    StringGetter getter;
+};
 
-static napi_value GetIncrementalVersion(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *incrementalVersion = GetIncrementalVersion();
+static const StringProperty STRING_PROPERTIES[] = {
+    { "deviceType", GetDeviceType },
+    { "manufacture", GetManufacture },
+    { "brand", GetBrand },
+    { "marketName", GetMarketName },
+    { "productSeries", GetProductSeries },
+    { "productModel", GetProductModel },
+    { "softwareModel", GetSoftwareModel },
+    { "hardwareModel", GetHardwareModel },
+    { "hardwareProfile", GetHardwareProfile },
+    { "serial", AclGetSerial },
+    { "bootloaderVersion", GetBootloaderVersion },
+    { "abiList", GetAbiList },
+    { "securityPatchTag", GetSecurityPatchTag },
+    { "displayVersion", GetDisplayVersion },
+    { "incrementalVersion", GetIncrementalVersion },
+    { "osReleaseType", GetOsReleaseType },
+    { "osFullName", GetOSFullName },
+    { "versionId", GetVersionId },
+    { "buildType", GetBuildType },
+    { "buildUser", GetBuildUser },
+    { "buildHost", GetBuildHost },
+    { "buildTime", GetBuildTime },
+    { "buildRootHash", GetBuildRootHash },
+    { "udid", GetDevUdid },
+};
+static constexpr size_t STRING_PROPERTY_COUNT = sizeof(STRING_PROPERTIES) / sizeof(STRING_PROPERTIES[0]);
 
-    NAPI_CALL(env, napi_create_string_utf8(env, incrementalVersion, strlen(incrementalVersion), &napiValue));
-    return napiValue;
-}
+// Holds the JS string of one property in one env, built on the first access
+using CachedString = struct {
+    StringGetter getter;
+    napi_ref ref;
+};
 
-static napi_value GetOsReleaseType(napi_env env, napi_callback_info info)
+static napi_value GetCachedString(napi_env env, napi_callback_info info)
 {
+    void *data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data));
+    CachedString *cached = static_cast<CachedString *>(data);
     napi_value napiValue = nullptr;
-    const char *osReleaseType = GetOsReleaseType();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, osReleaseType, strlen(osReleaseType), &napiValue));
+    if (cached->ref != nullptr) {
+        NAPI_CALL(env, napi_get_reference_value(env, cached->ref, &napiValue));
+        return napiValue;
+    }
+    const char *value = cached->getter();
+    if (value == nullptr) {
+        NAPI_CALL(env, napi_create_string_utf8(env, "", 0, &napiValue));
+        return napiValue;
+    }
+    NAPI_CALL(env, napi_create_string_utf8(env, value, strlen(value), &napiValue));
+    // Without the reference the value is only built again on the next access
+    (void)napi_create_reference(env, napiValue, 1, &cached->ref);
     return napiValue;
 }
 
-static napi_value GetOSFullName(napi_env env, napi_callback_info info)
+static void ReleaseStringCache(napi_env env, void *data, void *hint)
 {
-    napi_value napiValue = nullptr;
-    const char *osVersion = GetOSFullName();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, osVersion, strlen(osVersion), &napiValue));
-    return napiValue;
+    CachedString *strings = static_cast<CachedString *>(data);
+    for (size_t i = 0; i < STRING_PROPERTY_COUNT; i++) {
+        if (strings[i].ref != nullptr) {
+            napi_delete_reference(env, strings[i].ref);
+        }
+    }
+    delete[] strings;
 }
 
 static napi_value GetMajorVersion(napi_env env, napi_callback_info info)
@@ -230,112 +166,41 @@ static napi_value GetFirstApiVersion(napi_env env, napi_callback_info info)
     return napiValue;
 }
 
-static napi_value GetVersionId(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *versionId = GetVersionId();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, versionId, strlen(versionId), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBuildType(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *buildType = GetBuildType();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, buildType, strlen(buildType), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBuildUser(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *buildUser = GetBuildUser();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, buildUser, strlen(buildUser), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBuildHost(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *buildHost = GetBuildHost();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, buildHost, strlen(buildHost), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBuildTime(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *buildTime = GetBuildTime();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, buildTime, strlen(buildTime), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetBuildRootHash(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    const char *buildRootHash = GetBuildRootHash();
-
-    NAPI_CALL(env, napi_create_string_utf8(env, buildRootHash, strlen(buildRootHash), &napiValue));
-    return napiValue;
-}
-
-static napi_value GetDevUdid(napi_env env, napi_callback_info info)
-{
-    napi_value napiValue = nullptr;
-    char localDeviceId[UDID_LEN] = {0};
-    AclGetDevUdid(localDeviceId, UDID_LEN);
-
-    NAPI_CALL(env, napi_create_string_utf8(env, localDeviceId, strlen(localDeviceId), &napiValue));
-    return napiValue;
-}
-
 EXTERN_C_START
 /*
  * Module init
  */
 static napi_value Init(napi_env env, napi_value exports)
 {
+    /*
+     * The string cache lives as long as the exports of this env
+     */
+    CachedString *strings = new (std::nothrow) CachedString[STRING_PROPERTY_COUNT]();
+    NAPI_ASSERT(env, strings != nullptr, "Failed to create string cache");
+    napi_status status = napi_wrap(env, exports, strings, ReleaseStringCache, nullptr, nullptr);
+    if (status != napi_ok) {
+        delete[] strings;
+        NAPI_CALL(env, status);
+    }
+
     /*
      * Attribute definition
      */
-    napi_property_descriptor desc[] = {
-        {"deviceType", nullptr, nullptr, GetDeviceType, nullptr, nullptr, napi_default, nullptr},
-        {"manufacture", nullptr, nullptr, GetManufacture, nullptr, nullptr, napi_default, nullptr},
-        {"brand", nullptr, nullptr, GetBrand, nullptr, nullptr, napi_default, nullptr},
-        {"marketName", nullptr, nullptr, GetMarketName, nullptr, nullptr, napi_default, nullptr},
-        {"productSeries", nullptr, nullptr, GetProductSeries, nullptr, nullptr, napi_default, nullptr},
-        {"productModel", nullptr, nullptr, GetProductModel, nullptr, nullptr, napi_default, nullptr},
-        {"softwareModel", nullptr, nullptr, GetSoftwareModel, nullptr, nullptr, napi_default, nullptr},
-        {"hardwareModel", nullptr, nullptr, GetHardwareModel, nullptr, nullptr, napi_default, nullptr},
-        {"hardwareProfile", nullptr, nullptr, GetHardwareProfile, nullptr, nullptr, napi_default, nullptr},
-        {"serial", nullptr, nullptr, GetSerial, nullptr, nullptr, napi_default, nullptr},
-        {"bootloaderVersion", nullptr, nullptr, GetBootloaderVersion, nullptr, nullptr, napi_default, nullptr},
-        {"abiList", nullptr, nullptr, GetAbiList, nullptr, nullptr, napi_default, nullptr},
-        {"securityPatchTag", nullptr, nullptr, GetSecurityPatchTag, nullptr, nullptr, napi_default, nullptr},
-        {"displayVersion", nullptr, nullptr, GetDisplayVersion, nullptr, nullptr, napi_default, nullptr},
-        {"incrementalVersion", nullptr, nullptr, GetIncrementalVersion, nullptr, nullptr, napi_default, nullptr},
-        {"osReleaseType", nullptr, nullptr, GetOsReleaseType, nullptr, nullptr, napi_default, nullptr},
-        {"osFullName", nullptr, nullptr, GetOSFullName, nullptr, nullptr, napi_default, nullptr},
+    std::vector<napi_property_descriptor> desc;
+    for (size_t i = 0; i < STRING_PROPERTY_COUNT; i++) {
+        strings[i].getter = STRING_PROPERTIES[i].getter;
+        desc.push_back({STRING_PROPERTIES[i].name, nullptr, nullptr, GetCachedString, nullptr, nullptr,
+            napi_default, &strings[i]});
+    }
+    desc.insert(desc.end(), {
         {"majorVersion", nullptr, nullptr, GetMajorVersion, nullptr, nullptr, napi_default, nullptr},
         {"seniorVersion", nullptr, nullptr, GetSeniorVersion, nullptr, nullptr, napi_default, nullptr},
         {"featureVersion", nullptr, nullptr, GetFeatureVersion, nullptr, nullptr, napi_default, nullptr},
         {"buildVersion", nullptr, nullptr, GetBuildVersion, nullptr, nullptr, napi_default, nullptr},
         {"sdkApiVersion", nullptr, nullptr, GetSdkApiVersion, nullptr, nullptr, napi_default, nullptr},
         {"firstApiVersion", nullptr, nullptr, GetFirstApiVersion, nullptr, nullptr, napi_default, nullptr},
-        {"versionId", nullptr, nullptr, GetVersionId, nullptr, nullptr, napi_default, nullptr},
-        {"buildType", nullptr, nullptr, GetBuildType, nullptr, nullptr, napi_default, nullptr},
-        {"buildUser", nullptr, nullptr, GetBuildUser, nullptr, nullptr, napi_default, nullptr},
-        {"buildHost", nullptr, nullptr, GetBuildHost, nullptr, nullptr, napi_default, nullptr},
-        {"buildTime", nullptr, nullptr, GetBuildTime, nullptr, nullptr, napi_default, nullptr},
-        {"buildRootHash", nullptr, nullptr, GetBuildRootHash, nullptr, nullptr, napi_default, nullptr},
-        {"udid", nullptr, nullptr, GetDevUdid, nullptr, nullptr, napi_default, nullptr},
-    };
-    NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(napi_property_descriptor), desc));
+    });
+    NAPI_CALL(env, napi_define_properties(env, exports, desc.size(), desc.data()));
 
     return exports;
 }
@@ -13,14 +13,21 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <deque>
 #include <functional>
 #include <vector>
+#include <uv.h>
 #include "native_parameters_js.h"
 static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, 0, "StartupParametersJs" };
 using namespace OHOS::HiviewDFX;
 using namespace OHOS::system;
 static constexpr int ARGC_NUMBER = 2;
 static constexpr int BUF_LENGTH = 128;
+static constexpr size_t MAX_PENDING_CHANGES = 64;
+static constexpr uint64_t MS_PER_SECOND = 1000;
+static constexpr int WAIT_TIMEOUT = -10; // what WaitParameter returns once the timeout expired
+static constexpr int32_t DEFAULT_WAIT_TIMEOUT = 30; // seconds, what init waits for when given no timeout
 
 static napi_ref g_paramWatchRef;
 
@@ -38,6 +45,13 @@ using ParamAsyncContext = struct {
 
     int status = -1;
     std::string getValue;
+
+    // A wait is completed on the JS loop, by a change of its key or by its timer
+    uv_async_t satisfied {};
+    uv_timer_t timer {};
+    int openHandles = 0;
+    bool done = false;
+    bool fallback = false;
 };
 
 using ParamWatcher = struct {
@@ -50,17 +64,33 @@ using ParamWatcher = struct {
     std::mutex mutex {};
     napi_ref currCallbackRef = nullptr;
     std::map<uint32_t, napi_ref> callbackReferences {};
-};
 
-using ParamWatcherWork = struct {
-    napi_async_work work = nullptr;
-    ParamWatcher *watcher = nullptr;
-    bool startWatch = false;
+    // Changes wait here for the JS thread, a single delivery drains all of them
+    napi_threadsafe_function delivery = nullptr;
+    bool coalesce = false;
+    bool deliveryQueued = false;
+    bool released = false;
+    std::deque<std::pair<std::string, std::string>> pendingChanges {};
 };
 
 using ParamAsyncContextPtr = ParamAsyncContext *;
 using ParamWatcherPtr = ParamWatcher *;
 
+// The native watch of one key prefix, shared by the JS watchers switched on for it and the waits of that key
+using ParamWatchEntry = struct {
+    uint32_t id = 0; // context of the native watch
+    std::vector<ParamWatcherPtr> watchers {};
+    std::vector<ParamAsyncContextPtr> waiters {};
+};
+
+// Serializes the native watch and unwatch calls, g_watchEntriesMutex only guards the map
+static std::mutex g_watchSubscribeMutex;
+static std::mutex g_watchEntriesMutex;
+static std::map<std::string, ParamWatchEntry> g_watchEntries;
+static uint32_t g_watchEntryId = 0;
+
+static void DelWatcherEntry(ParamWatcherPtr watcher);
+
 static napi_value NapiGetNull(napi_env env)
 {
     napi_value result = 0;
@@ -89,6 +119,37 @@ static int GetParamValue(napi_env env, napi_value arg, napi_valuetype valueType,
     return status;
 }
 
+// Settles the promise or calls the callback of a wait with its status
+static void CompleteWait(napi_env env, ParamAsyncContextPtr asyncContext)
+{
+    napi_value result[ARGC_NUMBER] = { 0 };
+    napi_value message = nullptr;
+    napi_create_object(env, &result[0]);
+    napi_create_int32(env, asyncContext->status, &message);
+    napi_set_named_property(env, result[0], "code", message);
+    napi_get_undefined(env, &result[1]); // only one param
+
+    HiLog::Debug(LABEL, "JSApp Wait status: %{public}d, key: %{public}s ",
+        asyncContext->status, asyncContext->key);
+    if (asyncContext->deferred) {
+        if (asyncContext->status == 0) {
+            napi_resolve_deferred(env, asyncContext->deferred, result[1]);
+        } else {
+            napi_reject_deferred(env, asyncContext->deferred, result[0]);
+        }
+    } else {
+        napi_value callbackRef = nullptr;
+        napi_value callResult = nullptr;
+        napi_status status = napi_get_reference_value(env, asyncContext->callbackRef, &callbackRef);
+        PARAM_JS_CHECK(status == 0 && callbackRef != nullptr, return, "Failed to get reference ");
+        napi_value undefined;
+        napi_get_undefined(env, &undefined);
+        napi_call_function(env, undefined, callbackRef, ARGC_NUMBER, result, &callResult);
+        napi_delete_reference(env, asyncContext->callbackRef);
+    }
+}
+
+// Blocks a thread of the pool for the whole wait, only used when the key can't be watched
 static void WaitCallbackWork(napi_env env, ParamAsyncContextPtr asyncContext)
 {
     napi_value resource = nullptr;
@@ -103,31 +164,7 @@ static void WaitCallbackWork(napi_env env, ParamAsyncContextPtr asyncContext)
         },
         [](napi_env env, napi_status status, void *data) {
             ParamAsyncContext *asyncContext = (ParamAsyncContext *)data;
-            napi_value result[ARGC_NUMBER] = { 0 };
-            napi_value message = nullptr;
-            napi_create_object(env, &result[0]);
-            napi_create_int32(env, asyncContext->status, &message);
-            napi_set_named_property(env, result[0], "code", message);
-            napi_get_undefined(env, &result[1]); // only one param
-
-            HiLog::Debug(LABEL, "JSApp Wait status: %{public}d, key: %{public}s ",
-                asyncContext->status, asyncContext->key);
-            if (asyncContext->deferred) {
-                if (asyncContext->status == 0) {
-                    napi_resolve_deferred(env, asyncContext->deferred, result[1]);
-                } else {
-                    napi_reject_deferred(env, asyncContext->deferred, result[0]);
-                }
-            } else {
-                napi_value callbackRef = nullptr;
-                napi_value callResult = nullptr;
-                napi_status status = napi_get_reference_value(env, asyncContext->callbackRef, &callbackRef);
-                PARAM_JS_CHECK(status == 0 && callbackRef != nullptr, return, "Failed to get reference ");
-                napi_value undefined;
-                napi_get_undefined(env, &undefined);
-                napi_call_function(env, undefined, callbackRef, ARGC_NUMBER, result, &callResult);
-                napi_delete_reference(env, asyncContext->callbackRef);
-            }
+            CompleteWait(env, asyncContext);
             napi_delete_async_work(env, asyncContext->work);
             delete asyncContext;
         },
@@ -135,52 +172,9 @@ static void WaitCallbackWork(napi_env env, ParamAsyncContextPtr asyncContext)
     napi_queue_async_work(env, asyncContext->work);
 }
 
-napi_value ParamWait(napi_env env, napi_callback_info info)
+static bool IsWaitSatisfied(ParamAsyncContextPtr asyncContext, const char *value)
 {
-    constexpr int PARAM_TIMEOUT_INDEX = 2;
-    constexpr int ARGC_THREE_NUMBER = 3;
-    size_t argc = ARGC_THREE_NUMBER + 1;
-    napi_value argv[ARGC_THREE_NUMBER + 1];
-    napi_value thisVar = nullptr;
-    napi_status status = napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
-    PARAM_JS_CHECK(status == napi_ok, return GetNapiValue(env, status), "Failed to get cb info");
-    PARAM_JS_CHECK(argc >= ARGC_THREE_NUMBER, return GetNapiValue(env, status), "Failed to get argc");
-
-    ParamAsyncContextPtr asyncContext = new ParamAsyncContext();
-    PARAM_JS_CHECK(asyncContext != nullptr, return GetNapiValue(env, status), "Failed to create context");
-    asyncContext->env = env;
-
-    // get param key
-    asyncContext->keyLen = BUF_LENGTH - 1;
-    asyncContext->valueLen = BUF_LENGTH - 1;
-    size_t len = sizeof(asyncContext->timeout);
-    int ret = GetParamValue(env, argv[0], napi_string, asyncContext->key, asyncContext->keyLen);
-    PARAM_JS_CHECK(ret == 0, delete asyncContext;
-        return GetNapiValue(env, ret), "Invalid param for wait");
-    ret = GetParamValue(env, argv[1], napi_string, asyncContext->value, asyncContext->valueLen);
-    PARAM_JS_CHECK(ret == 0, delete asyncContext;
-        return GetNapiValue(env, ret), "Invalid param for wait");
-    ret = GetParamValue(env, argv[PARAM_TIMEOUT_INDEX], napi_number, (char *)&asyncContext->timeout, len);
-    PARAM_JS_CHECK(ret == 0, delete asyncContext;
-        return GetNapiValue(env, ret), "Invalid param for wait");
-    if (argc > ARGC_THREE_NUMBER) {
-        napi_valuetype valueType = napi_null;
-        napi_typeof(env, argv[ARGC_THREE_NUMBER], &valueType);
-        PARAM_JS_CHECK(valueType == napi_function, delete asyncContext;
-            return GetNapiValue(env, ret), "Invalid param for wait callbackRef");
-        napi_create_reference(env, argv[ARGC_THREE_NUMBER], 1, &asyncContext->callbackRef);
-    }
-    HiLog::Debug(LABEL, "JSApp Wait key: %{public}s, value: %{public}s timeout %{public}d.",
-        asyncContext->key, asyncContext->value, asyncContext->timeout);
-
-    napi_value result = nullptr;
-    if (asyncContext->callbackRef == nullptr) {
-        napi_create_promise(env, &asyncContext->deferred, &result);
-    } else {
-        result = GetNapiValue(env, 0);
-    }
-    WaitCallbackWork(env, asyncContext);
-    return result;
+    return (strcmp(asyncContext->value, "*") == 0) || (strcmp(asyncContext->value, value) == 0);
 }
 
 static bool GetFristRefence(ParamWatcherPtr watcher, uint32_t &next)
@@ -291,6 +285,37 @@ static bool CheckCallbackEqual(napi_env env, napi_value callback, ParamWatcherPt
     return false;
 }
 
+static void DeliverParamChanges(napi_env env, napi_value callback, void *context, void *data);
+
+// The delivery is closed once the JS object is finalized, or by the teardown of the env
+static void OnDeliveryClosed(napi_env env, void *data, void *hint)
+{
+    ParamWatcherPtr watcher = static_cast<ParamWatcherPtr>(data);
+    bool released = false;
+    {
+        std::lock_guard<std::mutex> lock(watcher->mutex);
+        watcher->delivery = nullptr;
+        released = watcher->released;
+    }
+    if (released) {
+        delete watcher;
+    }
+}
+
+static napi_status CreateDelivery(napi_env env, ParamWatcherPtr watcher)
+{
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "JSStartupWatchChange", NAPI_AUTO_LENGTH, &resource);
+    // One delivery queued at most, it takes every change pending when it runs
+    napi_status status = napi_create_threadsafe_function(env, nullptr, nullptr, resource, 1, 1,
+        watcher, OnDeliveryClosed, watcher, DeliverParamChanges, &watcher->delivery);
+    if (status != napi_ok) {
+        return status;
+    }
+    // Like the native watch, a watcher alone doesn't keep the event loop alive
+    return napi_unref_threadsafe_function(env, watcher->delivery);
+}
+
 static napi_value ParamWatchConstructor(napi_env env, napi_callback_info info)
 {
     size_t argc = 1;
@@ -302,6 +327,9 @@ static napi_value ParamWatchConstructor(napi_env env, napi_callback_info info)
     napi_status status = napi_create_reference(env, thisVar, 1, &watcher->thisVarRef);
     PARAM_JS_CHECK(status == 0, delete watcher;
         return NapiGetNull(env), "Failed to create reference %d", status);
+    status = CreateDelivery(env, watcher);
+    PARAM_JS_CHECK(status == 0, delete watcher;
+        return NapiGetNull(env), "Failed to create delivery %d", status);
 
     napi_wrap(
         env, thisVar, watcher,
@@ -309,8 +337,18 @@ static napi_value ParamWatchConstructor(napi_env env, napi_callback_info info)
             ParamWatcherPtr watcher = static_cast<ParamWatcherPtr>(data);
             if (watcher) {
                 DelCallback(env, nullptr, watcher);
-                WatchParameter(watcher->keyPrefix, nullptr, nullptr);
-                delete watcher;
+                DelWatcherEntry(watcher);
+                napi_threadsafe_function delivery = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(watcher->mutex);
+                    watcher->released = true;
+                    delivery = watcher->delivery;
+                }
+                if (delivery == nullptr) {
+                    delete watcher;
+                } else {
+                    napi_release_threadsafe_function(delivery, napi_tsfn_abort);
+                }
                 watcher = nullptr;
             }
         },
@@ -320,8 +358,8 @@ static napi_value ParamWatchConstructor(napi_env env, napi_callback_info info)
 
 napi_value GetWatcher(napi_env env, napi_callback_info info)
 {
-    size_t argc = 1;
-    napi_value argv[1];
+    size_t argc = ARGC_NUMBER;
+    napi_value argv[ARGC_NUMBER];
     napi_value thisVar = nullptr;
     void *data = nullptr;
     NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, &data));
@@ -341,9 +379,12 @@ napi_value GetWatcher(napi_env env, napi_callback_info info)
         watcher->keyLen = BUF_LENGTH;
         int ret = GetParamValue(env, argv[0], napi_string, watcher->keyPrefix, watcher->keyLen);
         PARAM_JS_CHECK(ret == 0, return NapiGetNull(env), "Failed to get key prefix");
+        PARAM_JS_CHECK(watcher->keyLen > 0, return NapiGetNull(env), "Invalid key prefix");
+        napi_valuetype valueType = napi_undefined;
+        if ((argc > 1) && (napi_typeof(env, argv[1], &valueType) == napi_ok) && (valueType == napi_boolean)) {
+            napi_get_value_bool(env, argv[1], &watcher->coalesce);
+        }
         HiLog::Debug(LABEL, "JSApp watcher keyPrefix = %{public}s ", watcher->keyPrefix);
-        ret = WatchParameter(watcher->keyPrefix, nullptr, watcher);
-        PARAM_JS_CHECK(ret == 0, return NapiGetNull(env), "Failed to get watcher ret %{public}d", ret);
     }
     return obj;
 }
@@ -404,9 +445,8 @@ static void NotifyValueChange(ParamWatcherPtr watcher, uint32_t id, napi_value t
     }
 }
 
-static void ProcessParamChange(const char *key, const char *value, void *context)
+static void ProcessParamChange(ParamWatcherPtr watcher, const char *key, const char *value)
 {
-    ParamWatcherPtr watcher = static_cast<ParamWatcherPtr>(context);
     PARAM_JS_CHECK(watcher != nullptr && watcher->env != nullptr, return, "Invalid param");
     PARAM_JS_CHECK(watcher->callbackReferences.size() > 0, return, "No callback for watcher");
 
@@ -430,35 +470,270 @@ static void ProcessParamChange(const char *key, const char *value, void *context
     HiLog::Debug(LABEL, "JSApp watcher ProcessParamChange %{public}s finish", key);
 }
 
-static void WatchCallbackWork(napi_env env, ParamWatcherPtr watcher)
+// Runs on the JS thread, or with a null env when the delivery is closed with changes still pending
+static void DeliverParamChanges(napi_env env, napi_value callback, void *context, void *data)
 {
-    HiLog::Debug(LABEL, "JSApp WatchCallbackWork key: %{public}s", watcher->keyPrefix);
-    ParamWatcherWork *worker = new ParamWatcherWork();
-    PARAM_JS_CHECK(worker != nullptr, return, "Failed to create worker ");
-    worker->watcher = watcher;
-    worker->work = nullptr;
-    worker->startWatch = watcher->startWatch;
+    ParamWatcherPtr watcher = static_cast<ParamWatcherPtr>(context);
+    if (env == nullptr) {
+        return;
+    }
+    std::deque<std::pair<std::string, std::string>> changes;
+    {
+        std::lock_guard<std::mutex> lock(watcher->mutex);
+        changes.swap(watcher->pendingChanges);
+        watcher->deliveryQueued = false;
+    }
+    for (const auto &change : changes) {
+        ProcessParamChange(watcher, change.first.c_str(), change.second.c_str());
+    }
+}
 
-    napi_value resource = nullptr;
-    napi_create_string_utf8(env, "JSStartupWatch", NAPI_AUTO_LENGTH, &resource);
-    napi_create_async_work(env, nullptr, resource,
-        [](napi_env env, void *data) {
-            ParamWatcherWork *worker = (ParamWatcherWork *)data;
-            PARAM_JS_CHECK(worker != nullptr && worker->watcher != nullptr, return, "Invalid worker ");
-            int status = WatchParameter(worker->watcher->keyPrefix,
-                worker->startWatch ? ProcessParamChange : nullptr, worker->watcher);
-            HiLog::Debug(LABEL, "JSApp WatchCallbackWork %{public}s status: %{public}d, key: %{public}s",
-                worker->startWatch ? "on" : "off", status, worker->watcher->keyPrefix);
-        },
-        [](napi_env env, napi_status status, void *data) {
-            ParamWatcherWork *worker = (ParamWatcherWork *)data;
-            HiLog::Debug(LABEL, "JSApp WatchCallbackWork delete %{public}s key: %{public}s",
-                worker->startWatch ? "on" : "off", worker->watcher->keyPrefix);
-            napi_delete_async_work(env, worker->work);
-            delete worker;
-        },
-        (void *)worker, &worker->work);
-    napi_queue_async_work(env, worker->work);
+/*
+ * Called on the native watch thread. The change waits with the others not delivered yet, replacing the
+ * pending value of the same key when coalescing, and the oldest one is dropped when too many are waiting.
+ */
+static void QueueParamChange(ParamWatcherPtr watcher, const char *key, const char *value)
+{
+    std::lock_guard<std::mutex> lock(watcher->mutex);
+    if (watcher->delivery == nullptr) {
+        return;
+    }
+    auto &pending = watcher->pendingChanges;
+    auto iter = pending.end();
+    if (watcher->coalesce) {
+        iter = std::find_if(pending.begin(), pending.end(),
+            [key](const std::pair<std::string, std::string> &change) { return change.first == key; });
+    }
+    if (iter != pending.end()) {
+        iter->second = value;
+    } else {
+        if (pending.size() >= MAX_PENDING_CHANGES) {
+            HiLog::Warn(LABEL, "JSApp watcher %{public}s drops change of %{public}s",
+                watcher->keyPrefix, pending.front().first.c_str());
+            pending.pop_front();
+        }
+        pending.emplace_back(key, value);
+    }
+    if (!watcher->deliveryQueued) {
+        watcher->deliveryQueued =
+            napi_call_threadsafe_function(watcher->delivery, nullptr, napi_tsfn_nonblocking) == napi_ok;
+    }
+}
+
+// Called by the native watch of a prefix, under the lock a watcher is removed with, so none goes away meanwhile
+static void OnWatchedChange(const char *key, const char *value, void *context)
+{
+    uint32_t id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context));
+    std::lock_guard<std::mutex> lock(g_watchEntriesMutex);
+    for (auto &entry : g_watchEntries) {
+        if (entry.second.id != id) {
+            continue;
+        }
+        for (ParamWatcherPtr watcher : entry.second.watchers) {
+            QueueParamChange(watcher, key, value);
+        }
+        for (ParamAsyncContextPtr waiter : entry.second.waiters) {
+            if ((strcmp(key, waiter->key) == 0) && IsWaitSatisfied(waiter, value)) {
+                waiter->status = 0;
+                uv_async_send(&waiter->satisfied);
+            }
+        }
+        break;
+    }
+}
+
+// Only the first user of a prefix watches it natively, the next ones join its entry
+static int AddWatchEntry(const char *prefix, const std::function<void(ParamWatchEntry &)> &join)
+{
+    std::lock_guard<std::mutex> subscribeLock(g_watchSubscribeMutex);
+    {
+        std::lock_guard<std::mutex> lock(g_watchEntriesMutex);
+        auto iter = g_watchEntries.find(prefix);
+        if (iter != g_watchEntries.end()) {
+            join(iter->second);
+            return 0;
+        }
+    }
+    ParamWatchEntry entry;
+    entry.id = ++g_watchEntryId;
+    join(entry);
+    int ret = WatchParameter(prefix, OnWatchedChange, reinterpret_cast<void *>(uintptr_t(entry.id)));
+    HiLog::Debug(LABEL, "JSApp watch %{public}s status: %{public}d", prefix, ret);
+    if (ret == 0) {
+        std::lock_guard<std::mutex> lock(g_watchEntriesMutex);
+        g_watchEntries.emplace(prefix, std::move(entry));
+    }
+    return ret;
+}
+
+// The native watch is cancelled with the last user of the prefix, outside of the lock taken by the callback
+static void DelWatchEntry(const char *prefix, const std::function<void(ParamWatchEntry &)> &leave)
+{
+    std::lock_guard<std::mutex> subscribeLock(g_watchSubscribeMutex);
+    uint32_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_watchEntriesMutex);
+        auto iter = g_watchEntries.find(prefix);
+        if (iter == g_watchEntries.end()) {
+            return;
+        }
+        leave(iter->second);
+        if (!iter->second.watchers.empty() || !iter->second.waiters.empty()) {
+            return;
+        }
+        id = iter->second.id;
+        g_watchEntries.erase(iter);
+    }
+    int ret = WatchParameter(prefix, nullptr, reinterpret_cast<void *>(uintptr_t(id)));
+    HiLog::Debug(LABEL, "JSApp unwatch %{public}s status: %{public}d", prefix, ret);
+}
+
+static void DelWatcherEntry(ParamWatcherPtr watcher)
+{
+    DelWatchEntry(watcher->keyPrefix, [watcher](ParamWatchEntry &entry) {
+        auto &watchers = entry.watchers;
+        watchers.erase(std::remove(watchers.begin(), watchers.end(), watcher), watchers.end());
+    });
+}
+
+static void OnWaitHandleClosed(uv_handle_t *handle)
+{
+    ParamAsyncContextPtr asyncContext = static_cast<ParamAsyncContextPtr>(handle->data);
+    if (--asyncContext->openHandles > 0) {
+        return;
+    }
+    if (asyncContext->fallback) {
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(asyncContext->env, &scope);
+        WaitCallbackWork(asyncContext->env, asyncContext);
+        napi_close_handle_scope(asyncContext->env, scope);
+    } else {
+        delete asyncContext;
+    }
+}
+
+static void CloseWaitHandles(ParamAsyncContextPtr asyncContext)
+{
+    uv_timer_stop(&asyncContext->timer);
+    uv_close(reinterpret_cast<uv_handle_t *>(&asyncContext->timer), OnWaitHandleClosed);
+    uv_close(reinterpret_cast<uv_handle_t *>(&asyncContext->satisfied), OnWaitHandleClosed);
+}
+
+// Runs on the JS loop, once the key holds the value, the timer expired or the watch failed
+static void FinishWait(ParamAsyncContextPtr asyncContext)
+{
+    if (asyncContext->done) {
+        return;
+    }
+    asyncContext->done = true;
+    // Out of the entry, the native watch thread doesn't signal the wait any more
+    DelWatchEntry(asyncContext->key, [asyncContext](ParamWatchEntry &entry) {
+        auto &waiters = entry.waiters;
+        waiters.erase(std::remove(waiters.begin(), waiters.end(), asyncContext), waiters.end());
+    });
+    napi_handle_scope scope = nullptr;
+    napi_open_handle_scope(asyncContext->env, &scope);
+    CompleteWait(asyncContext->env, asyncContext);
+    napi_close_handle_scope(asyncContext->env, scope);
+    CloseWaitHandles(asyncContext);
+}
+
+static void OnWaitSatisfied(uv_async_t *handle)
+{
+    FinishWait(static_cast<ParamAsyncContextPtr>(handle->data));
+}
+
+static void OnWaitTimeout(uv_timer_t *handle)
+{
+    FinishWait(static_cast<ParamAsyncContextPtr>(handle->data));
+}
+
+/*
+ * No thread is held while waiting: the wait joins the watch of its key and is completed on the JS loop,
+ * by the change to the value or by a timer. Without a native watch it falls back to a blocking wait.
+ * A timeout of 0 or less waits as long as init would, so the timer always settles the wait in the end
+ * and never keeps the loop alive for ever.
+ */
+static int StartWait(napi_env env, ParamAsyncContextPtr asyncContext)
+{
+    uv_loop_s *loop = nullptr;
+    napi_status status = napi_get_uv_event_loop(env, &loop);
+    PARAM_JS_CHECK(status == napi_ok && loop != nullptr, return -1, "Failed to get event loop");
+    asyncContext->satisfied.data = asyncContext;
+    asyncContext->timer.data = asyncContext;
+    uv_async_init(loop, &asyncContext->satisfied, OnWaitSatisfied);
+    uv_timer_init(loop, &asyncContext->timer);
+    asyncContext->openHandles = ARGC_NUMBER;
+    asyncContext->status = WAIT_TIMEOUT;
+
+    int ret = AddWatchEntry(asyncContext->key,
+        [asyncContext](ParamWatchEntry &entry) { entry.waiters.push_back(asyncContext); });
+    if (ret != 0) {
+        asyncContext->fallback = true;
+        CloseWaitHandles(asyncContext);
+        return 0;
+    }
+    int32_t timeout = (asyncContext->timeout > 0) ? asyncContext->timeout : DEFAULT_WAIT_TIMEOUT;
+    uv_timer_start(&asyncContext->timer, OnWaitTimeout, uint64_t(timeout) * MS_PER_SECOND, 0);
+    // The key may hold the value since before the watch started
+    char value[BUF_LENGTH] = { 0 };
+    if ((GetParameter(asyncContext->key, "", value, sizeof(value)) > 0) && IsWaitSatisfied(asyncContext, value)) {
+        {
+            std::lock_guard<std::mutex> lock(g_watchEntriesMutex);
+            asyncContext->status = 0;
+        }
+        uv_async_send(&asyncContext->satisfied);
+    }
+    return 0;
+}
+
+napi_value ParamWait(napi_env env, napi_callback_info info)
+{
+    constexpr int PARAM_TIMEOUT_INDEX = 2;
+    constexpr int ARGC_THREE_NUMBER = 3;
+    size_t argc = ARGC_THREE_NUMBER + 1;
+    napi_value argv[ARGC_THREE_NUMBER + 1];
+    napi_value thisVar = nullptr;
+    napi_status status = napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+    PARAM_JS_CHECK(status == napi_ok, return GetNapiValue(env, status), "Failed to get cb info");
+    PARAM_JS_CHECK(argc >= ARGC_THREE_NUMBER, return GetNapiValue(env, status), "Failed to get argc");
+
+    ParamAsyncContextPtr asyncContext = new ParamAsyncContext();
+    PARAM_JS_CHECK(asyncContext != nullptr, return GetNapiValue(env, status), "Failed to create context");
+    asyncContext->env = env;
+
+    // get param key
+    asyncContext->keyLen = BUF_LENGTH - 1;
+    asyncContext->valueLen = BUF_LENGTH - 1;
+    size_t len = sizeof(asyncContext->timeout);
+    int ret = GetParamValue(env, argv[0], napi_string, asyncContext->key, asyncContext->keyLen);
+    PARAM_JS_CHECK(ret == 0, delete asyncContext;
+        return GetNapiValue(env, ret), "Invalid param for wait");
+    ret = GetParamValue(env, argv[1], napi_string, asyncContext->value, asyncContext->valueLen);
+    PARAM_JS_CHECK(ret == 0, delete asyncContext;
+        return GetNapiValue(env, ret), "Invalid param for wait");
+    ret = GetParamValue(env, argv[PARAM_TIMEOUT_INDEX], napi_number, (char *)&asyncContext->timeout, len);
+    PARAM_JS_CHECK(ret == 0, delete asyncContext;
+        return GetNapiValue(env, ret), "Invalid param for wait");
+    if (argc > ARGC_THREE_NUMBER) {
+        napi_valuetype valueType = napi_null;
+        napi_typeof(env, argv[ARGC_THREE_NUMBER], &valueType);
+        PARAM_JS_CHECK(valueType == napi_function, delete asyncContext;
+            return GetNapiValue(env, ret), "Invalid param for wait callbackRef");
+        napi_create_reference(env, argv[ARGC_THREE_NUMBER], 1, &asyncContext->callbackRef);
+    }
+    HiLog::Debug(LABEL, "JSApp Wait key: %{public}s, value: %{public}s timeout %{public}d.",
+        asyncContext->key, asyncContext->value, asyncContext->timeout);
+
+    napi_value result = nullptr;
+    if (asyncContext->callbackRef == nullptr) {
+        napi_create_promise(env, &asyncContext->deferred, &result);
+    } else {
+        result = GetNapiValue(env, 0);
+    }
+    ret = StartWait(env, asyncContext);
+    PARAM_JS_CHECK(ret == 0, WaitCallbackWork(env, asyncContext), "Failed to start wait");
+    return result;
 }
 
 static napi_value SwithWatchOn(napi_env env, napi_callback_info info)
@@ -486,9 +761,14 @@ static napi_value SwithWatchOn(napi_env env, napi_callback_info info)
     }
 
     HiLog::Debug(LABEL, "JSApp watcher add %{public}s", watcher->keyPrefix);
-    WatchCallbackWork(env, watcher);
+    int ret = AddWatchEntry(watcher->keyPrefix,
+        [watcher](ParamWatchEntry &entry) { entry.watchers.push_back(watcher); });
+    if (ret != 0) {
+        std::lock_guard<std::mutex> lock(watcher->mutex);
+        watcher->startWatch = false;
+    }
     HiLog::Debug(LABEL, "JSApp watcher on %{public}s finish", watcher->keyPrefix);
-    return GetNapiValue(env, 0);
+    return GetNapiValue(env, ret);
 }
 
 static napi_value SwithWatchOff(napi_env env, napi_callback_info info)
@@ -498,12 +778,14 @@ static napi_value SwithWatchOff(napi_env env, napi_callback_info info)
     PARAM_JS_CHECK(watcher != nullptr, return GetNapiValue(env, -1), "Failed to get watcher");
     HiLog::Debug(LABEL, "JSApp watcher off %{public}s", watcher->keyPrefix);
     DelCallback(env, callback, watcher);
+    bool stopWatch = false;
     {
         std::lock_guard<std::mutex> lock(watcher->mutex);
-        if (watcher->callbackReferences.size() == 0) {
-            watcher->startWatch = false;
-            WatchCallbackWork(env, watcher);
-        }
+        stopWatch = watcher->startWatch && (watcher->callbackReferences.size() == 0);
+        watcher->startWatch = watcher->startWatch && !stopWatch;
+    }
+    if (stopWatch) {
+        DelWatcherEntry(watcher);
     }
     return GetNapiValue(env, 0);
 }
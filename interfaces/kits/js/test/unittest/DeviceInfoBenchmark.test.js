@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import {describe, it, expect} from 'deccjsunit/index'
+import deviceinfo from '@ohos.deviceInfo'
+
+const BENCH_READS = 20000;
+
+// A few of the string properties the module builds once per env, then returns from a reference
+const STRING_PROPERTIES = ['brand', 'productModel', 'osFullName', 'versionId'];
+
+// Date only counts milliseconds, the loop has to be long enough for a per read figure
+function bench(read) {
+    let start = new Date().getTime();
+    for (let i = 0; i < BENCH_READS; i++) {
+        read();
+    }
+    return (new Date().getTime() - start) * 1000000 / BENCH_READS;
+}
+
+describe('DeviceInfoBenchmarkTest', function () {
+    /**
+     * @tc.name: deviceInfoBenchmark001
+     * @tc.desc: Times repeated reads of the cached string properties. majorVersion still builds
+     *           a new value on every read and is timed alongside for reference.
+     * @tc.type: PERF
+     */
+    it('deviceInfoBenchmark001', 0, function () {
+        for (let name of STRING_PROPERTIES) {
+            let value = deviceinfo[name];
+            expect(typeof value).assertEqual('string');
+            let length = 0;
+            let nanosPerRead = bench(function () {
+                length += deviceinfo[name].length;
+            });
+            expect(length).assertEqual(value.length * BENCH_READS);
+            expect(deviceinfo[name]).assertEqual(value);
+            console.info(name + ' ' + nanosPerRead + ' ns per read');
+        }
+        let sum = 0;
+        let major = deviceinfo.majorVersion;
+        let nanosPerRead = bench(function () {
+            sum += deviceinfo.majorVersion;
+        });
+        expect(sum).assertEqual(major * BENCH_READS);
+        console.info('majorVersion ' + nanosPerRead + ' ns per read');
+    })
+})
@@ -81,6 +81,59 @@ int GetParameter(const char *key, const char *def, char *value, unsigned int len
  */
 int SetParameter(const char *key, const char *value);
 
+/**
+ * @brief Describes one system parameter of a batch read.
+ *
+ * @since 1.1
+ * @version 1.1
+ */
+typedef struct {
+    /** Key of the system parameter to query, same restrictions as for {@link GetParameter} */
+    const char *key;
+    /** Default value to return when no query result is found, can be <b>NULL</b> */
+    const char *def;
+    /** Data buffer that stores the query result, applied for and released by the caller */
+    char *value;
+    /** Length of the data buffer */
+    unsigned int len;
+    /** Result of this key, set to what {@link GetParameter} would have returned for it */
+    int ret;
+} ParameterItem;
+
+/**
+ * @brief Obtains several system parameters in one pass.
+ *
+ * Each item is resolved exactly like {@link GetParameter} and its result is stored in <b>ret</b> of the item,
+ * so that one missing or invalid key does not fail the others.\n
+ *
+ * @param items Indicates the array of parameters to query.
+ * @param count Indicates the number of items in the array.
+ * @return Returns the number of items whose <b>ret</b> is not negative;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+int GetParameters(ParameterItem *items, unsigned int count);
+
+/**
+ * @brief Sets or updates several system parameters at once.
+ *
+ * The file, arena and journal storages commit the batch to the storage once: a crash leaves either
+ * all of it or none of it, and a concurrent {@link GetParameters} observes all of the new values
+ * or none of them. Devices without a file system write the keys one after the other, so a failure
+ * may leave the first ones set and a concurrent reader may observe part of the batch.\n
+ *
+ * @param keys Indicates the keys of the parameters to set, same restrictions as for {@link SetParameter}.
+ * @param values Indicates the values, <b>values[i]</b> being the value of <b>keys[i]</b>.
+ * @param count Indicates the number of keys.
+ * @return Returns <b>0</b> if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect, in which case nothing is set;
+ * returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+int SetParameters(const char *keys[], const char *values[], unsigned int count);
+
 /**
  * @brief Wait for a system parameter with specified value.
  *
@@ -119,6 +172,96 @@ int WaitParameter(const char *key, const char *value, int timeout);
 typedef void (*ParameterChgPtr)(const char *key, const char *value, void *context);
 int WatchParameter(const char *keyprefix, ParameterChgPtr callback, void *context);
 
+/**
+ * @brief Visits the system parameters whose key starts with a prefix.
+ *
+ * The values are read while the parameters are visited, a parameter stored concurrently may be
+ * visited with its old or its new value.\n
+ * There is no index of the keys by prefix: every key of the store is compared with the prefix,
+ * so a visit costs as much as the number of parameters stored, however few of them match.
+ * It is meant for diagnostics, not for paths that run often.\n
+ *
+ * @param prefix Indicates the key prefix of the parameters to visit, "A.B." for example.
+ * An empty prefix visits every parameter.
+ * @param visitor Indicates the function called once for each parameter with its key and value.
+ * Returning a value other than <b>0</b> stops the visit.
+ * @param context Indicates the pointer passed to <b>visitor</b> as it is.
+ * @return Returns the number of parameters visited if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+typedef int (*ParameterVisitor)(const char *key, const char *value, void *context);
+int ForEachParameter(const char *prefix, ParameterVisitor visitor, void *context);
+
+/**
+ * @brief Obtains a handle of a system parameter.
+ *
+ * The handle stays valid for the life of the process, it avoids looking the key up again
+ * to read the parameter or to tell whether it changed.\n
+ *
+ * @param key Indicates the key of a system parameter that is stored.
+ * @return Returns the handle of the parameter if the operation is successful;
+ * returns <b>-1</b> if the parameter doesn't exist or in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+unsigned int FindParameter(const char *key);
+
+/**
+ * @brief Obtains the commit ID of a system parameter.
+ *
+ * The commit ID changes whenever the parameter is stored, and may change when other parameters are,
+ * so an unchanged commit ID means an unchanged value. Obtain it before reading the value.\n
+ *
+ * @param handle Indicates the handle returned by <b>FindParameter</b>.
+ * @return Returns the commit ID if the operation is successful; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+unsigned int GetParameterCommitId(unsigned int handle);
+
+/**
+ * @brief Obtains the key of a system parameter from its handle.
+ *
+ * @param handle Indicates the handle returned by <b>FindParameter</b>.
+ * @param key Indicates the buffer receiving the key.
+ * @param len Indicates the length of the buffer.
+ * @return Returns the length of the key if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+int GetParameterName(unsigned int handle, char *key, unsigned int len);
+
+/**
+ * @brief Obtains the value of a system parameter from its handle.
+ *
+ * @param handle Indicates the handle returned by <b>FindParameter</b>.
+ * @param value Indicates the buffer receiving the value.
+ * @param len Indicates the length of the buffer.
+ * @return Returns the length of the value if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+int GetParameterValue(unsigned int handle, char *value, unsigned int len);
+
+/**
+ * @brief Obtains the change sequence number of system parameters.
+ *
+ * The sequence number moves on whenever a parameter it covers is stored, and may move on when other
+ * parameters are, so an unchanged sequence number means that none of them changed.\n
+ *
+ * @param prefix Indicates the parameters covered: the ones whose key starts with <b>prefix</b> when it
+ * ends with a dot, "A.B." for example, the parameter <b>prefix</b> otherwise, every parameter when it is empty.
+ * @return Returns the sequence number if the operation is successful;
+ * returns <b>-9</b> if a parameter is incorrect; returns <b>-1</b> in other scenarios.
+ * @since 1.1
+ * @version 1.1
+ */
+long long GetParameterSequence(const char *prefix);
+
 /**
  * @brief Obtains the device type.
  *